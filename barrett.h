@@ -0,0 +1,48 @@
+#ifndef FDS_BARRETT_
+#define FDS_BARRETT_
+
+#include "big_integer.h"
+
+// 模任意正整数 n 的 Barrett 约简上下文
+// 预处理一次 mu = floor(b^{2k} / n)，其中 b = 2^LIMB_LEN，k 为模数 n 所占的块数；之后约简一个不超过 2k 块的数只需要两次乘法和几次减法
+// 与 MontgomeryContext 不同，模数可以是偶数，输入输出也都是普通形式，适合模数经常更换或者需要直接约简很多数的场合
+// 中间结果可能超过 2^M，统一放在宽度约为 2M 的 Wide 中计算
+template <std::size_t M>
+class BarrettContext {
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef typename Integer::Limb Limb;
+
+ private: // 常量
+  constexpr static std::size_t LIMB_LEN = Integer::LIMB_LEN;
+  constexpr static std::size_t LIMIT_NUMS = Integer::LIMIT_NUMS;
+  constexpr static std::size_t WIDE_BITS = (2 * LIMIT_NUMS + 2) * LIMB_LEN; // 能放下两个 M 位数的乘积和 b^{2k}
+  typedef BigInteger<WIDE_BITS> Wide;
+
+ private: // 预处理得到的数据
+  Integer n;       // 模数
+  std::size_t k;   // 模数所占的块数
+  Wide n_wide;     // 模数的宽版本
+  Wide mu;         // floor(b^{2k} / n)，不超过 k + 1 块
+
+ public: // 构造函数，模数为 0 时 throw std::logic_error
+  explicit BarrettContext(const Integer &modulus);
+
+ public: // 获取模数
+  auto modulus() const -> const Integer&;
+
+ public: // 模运算，输入可以是任意 [0, 2^M) 中的数
+  auto reduce(const Integer &a) const -> Integer; // a mod n
+  auto reduce(const BigInteger<2 * M> &a) const -> Integer; // a mod n，a 可以是 mul_wide 得到的完整乘积
+  auto mulmod(const Integer &a, const Integer &b) const -> Integer; // a * b mod n，乘积不会被截断
+  auto powmod(const Integer &a, const Integer &e) const -> Integer; // a ^ e mod n
+
+ private: // 辅助函数
+  auto reduce_wide(const Wide &x) const -> Integer; // x mod n，x 不超过 2k 块时直接约简，否则每次并入 k 块
+  auto barrett(const Wide &x) const -> Wide; // x mod n，要求 x < b^{2k}
+  static auto slice(const Wide &a, std::size_t lo, std::size_t hi) -> Wide; // 第 [lo, hi) 块组成的数
+};
+
+#endif //FDS_BARRETT_
+
+#include "barrett_impl.h"
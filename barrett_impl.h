@@ -0,0 +1,105 @@
+#ifndef FDS_BARRETT_IMPL_
+#define FDS_BARRETT_IMPL_
+
+#include "barrett.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// BarrettContext 构造函数实现
+// 只在这里用一次除法求出 mu
+
+template<std::size_t M>
+BarrettContext<M>::BarrettContext(const Integer &modulus) : n(modulus), k(modulus.data.size()) {
+  if (n.data.empty())
+    throw std::logic_error("modulus of BarrettContext must be positive");
+
+  n_wide = n.template widen<WIDE_BITS>();
+  mu = (Wide(1) << (2 * k * LIMB_LEN)) / n_wide;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 获取模数
+
+template<std::size_t M>
+auto BarrettContext<M>::modulus() const -> const Integer& { return n; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模运算
+
+template<std::size_t M>
+auto BarrettContext<M>::reduce(const Integer &a) const -> Integer {
+  if (a < n)
+    return a;
+  return reduce_wide(a.template widen<WIDE_BITS>());
+}
+
+template<std::size_t M>
+auto BarrettContext<M>::reduce(const BigInteger<2 * M> &a) const -> Integer {
+  return reduce_wide(a.template widen<WIDE_BITS>());
+}
+
+template<std::size_t M>
+auto BarrettContext<M>::mulmod(const Integer &a, const Integer &b) const -> Integer {
+  return reduce_wide(a.template widen<WIDE_BITS>() * b.template widen<WIDE_BITS>());
+}
+
+template<std::size_t M>
+auto BarrettContext<M>::powmod(const Integer &a, const Integer &e) const -> Integer {
+  return Integer::pow_sliding_window_impl(reduce(a), e, reduce(Integer(1)),
+      [this](const Integer &x, const Integer &y) { return mulmod(x, y); },
+      [this](const Integer &x) { return barrett(Wide::sqr(x.template widen<WIDE_BITS>())).template narrow<M>(); });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 reduce_wide
+// 超过 2k 块时把 x 看成 b^k 进制，先约简最高的两位，之后每次把余数左移 k 块并入下一位再约简
+// 余数小于 n <= b^k，并入后仍然小于 b^{2k}
+
+template<std::size_t M>
+auto BarrettContext<M>::reduce_wide(const Wide &x) const -> Integer {
+  std::size_t size = x.data.size();
+  if (size <= 2 * k)
+    return barrett(x).template narrow<M>();
+
+  std::size_t digits = (size + k - 1) / k;
+  Wide r = barrett(slice(x, (digits - 2) * k, size));
+  for (std::size_t i = digits - 2; i > 0; --i)
+    r = barrett((r << (k * LIMB_LEN)) + slice(x, (i - 1) * k, i * k));
+  return r.template narrow<M>();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 barrett
+// q = floor(floor(x / b^{k-1}) * mu / b^{k+1}) 比真实的商至多小 2，r = x - q * n 只需要计算低 k + 1 块
+// 因此 r 最后至多再减去两次 n
+
+template<std::size_t M>
+auto BarrettContext<M>::barrett(const Wide &x) const -> Wide {
+  Wide q = slice(slice(x, k - 1, 2 * k) * mu, k + 1, 2 * k + 2);
+  Wide r = slice(x, 0, k + 1), t = Wide::mul_short(q, n_wide, k + 1);
+
+  if (r < t)
+    r += Wide(1) << ((k + 1) * LIMB_LEN);
+  r -= t;
+  while (r >= n_wide)
+    r -= n_wide;
+  return r;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 slice
+
+template<std::size_t M>
+auto BarrettContext<M>::slice(const Wide &a, std::size_t lo, std::size_t hi) -> Wide {
+  hi = hi < a.data.size() ? hi : a.data.size();
+  Wide result;
+  if (lo >= hi)
+    return result;
+  result.data.resize(hi - lo, 0);
+  std::copy(a.data.begin() + lo, a.data.begin() + hi, result.data.begin());
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_BARRETT_IMPL_
@@ -0,0 +1,364 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "big_integer.h"
+#include "montgomery.h"
+#include "barrett.h"
+#include "big_integer_batch.h"
+#include "fixed_base_pow.h"
+#include "big_integer_expr.h"
+#include "big_integer_literal.h"
+
+// 通过友元直接调用 BigInteger 的内部算法，便于分别测量每一种实现
+struct BigIntegerAccess {
+  template <std::size_t M> using Integer = BigInteger<M>;
+
+  template <std::size_t M>
+  static auto limb_bits() -> std::size_t { return Integer<M>::LIMB_LEN; }
+  template <std::size_t M>
+  static auto low_limb(const Integer<M> &x) -> std::uint64_t { return x.data.empty() ? 0 : x.data.front(); }
+
+  template <std::size_t M>
+  static auto add(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::add(a, b); }
+  template <std::size_t M>
+  static auto sub(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::sub(a, b); }
+  template <std::size_t M>
+  static auto mul_base(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_base(a, b); }
+  template <std::size_t M>
+  static auto mul_karatsuba(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_karatsuba(a, b); }
+  template <std::size_t M>
+  static auto mul_toom3(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_toom3(a, b); }
+  template <std::size_t M>
+  static auto mul_toom4(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_toom4(a, b); }
+  template <std::size_t M>
+  static auto mul_ntt(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_ntt(a, b); }
+  template <std::size_t M>
+  static auto mul_short(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::mul_short(a, b, Integer<M>::LIMIT_NUMS); }
+  template <std::size_t M>
+  static auto sqr_karatsuba_full(const Integer<M> &a) -> Integer<M> { return Integer<M>::sqr_karatsuba(a); }
+  template <std::size_t M>
+  static auto sqr_short(const Integer<M> &a) -> Integer<M> { return Integer<M>::sqr_short(a, Integer<M>::LIMIT_NUMS); }
+  template <std::size_t M>
+  static auto sqr_base(const Integer<M> &a) -> Integer<M> { return Integer<M>::sqr_base(a); }
+  template <std::size_t M>
+  static auto sqr_karatsuba(const Integer<M> &a) -> Integer<M> { return Integer<M>::sqr_karatsuba(a); }
+  template <std::size_t M>
+  static auto div_base(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::div_base(a, b); }
+  template <std::size_t M>
+  static auto div_binary_search(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::div_binary_search(a, b); }
+  template <std::size_t M>
+  static auto div_knuth(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::divmod(a, b).first; }
+  template <std::size_t M>
+  static auto pow_base(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::pow_base(a, b); }
+  template <std::size_t M>
+  static auto pow_packing(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::pow_packing(a, b); }
+  template <std::size_t M>
+  static auto pow_sliding_window(const Integer<M> &a, const Integer<M> &b) -> Integer<M> { return Integer<M>::pow_sliding_window(a, b); }
+  template <std::size_t M>
+  static auto to_dec(const Integer<M> &a) -> std::string {
+    std::string s;
+    Integer<M>::binary_to_decimal(a.data, s);
+    return s;
+  }
+};
+
+namespace {
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 命令行选项与测量结果
+
+struct Options {
+  std::string format = "csv";   // 输出格式：csv 或 json
+  std::string output;           // 输出文件，为空时输出到标准输出
+  std::string filter;           // 只运行名称中包含该子串的操作
+  double min_time_ms = 100;     // 每一项至少运行的时间
+  bool full = false;            // 为 true 时不跳过开销过大的组合
+};
+
+struct Record {
+  std::string operation;
+  std::size_t bits;          // 模数位数 M
+  std::size_t operand_bits;  // 操作数位数
+  std::size_t limb_bits;     // 每块的位数
+  std::size_t iterations;
+  double ns_per_op;
+};
+
+Options options;
+std::vector<Record> records;
+volatile std::uint64_t sink; // 防止结果被优化掉
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 反复执行 f 直到总耗时不少于 min_time_ms，返回平均每次的纳秒数
+
+template <class F>
+auto measure(F f, std::size_t &iterations) -> double {
+  typedef std::chrono::steady_clock Clock;
+  const double limit = options.min_time_ms * 1e6;
+
+  iterations = 0;
+  std::size_t batch = 1;
+  double elapsed = 0;
+
+  while (elapsed < limit) {
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < batch; ++i)
+      f();
+    elapsed += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    iterations += batch;
+
+    // 逐步增大每批次数，减少计时开销
+    if (batch < 1024) batch *= 2;
+  }
+
+  return elapsed / (double)iterations;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 生成最高位为 1 的 bits 位随机数
+
+template <std::size_t M>
+auto random_integer(std::mt19937_64 &rng, std::size_t bits) -> BigInteger<M> {
+  static const char digits[] = "0123456789abcdef";
+  std::string s;
+
+  std::size_t head = bits % 4 == 0 ? 4 : bits % 4;
+  s.push_back(digits[(1u << (head - 1)) | (rng() & ((1u << (head - 1)) - 1))]);
+  for (std::size_t i = head; i < bits; i += 4)
+    s.push_back(digits[rng() & 15]);
+
+  return BigInteger<M>::from_hex(s);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 测量一项操作，max_bits 为默认情况下允许运行的最大 M，避免个别平方级或更慢的实现拖垮整个测试
+
+template <std::size_t M, class F>
+auto run(const std::string &name, std::size_t operand_bits, std::size_t max_bits, F f) -> void {
+  if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+    return;
+  if (!options.full && M > max_bits)
+    return;
+
+  std::size_t iterations;
+  double ns = measure(f, iterations);
+  records.push_back({name, M, operand_bits, BigIntegerAccess::limb_bits<M>(), iterations, ns});
+  std::cerr << name << " M=" << M << ": " << ns << " ns/op" << std::endl;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 对给定的 M 运行所有算法
+
+template <std::size_t M>
+auto run_suite() -> void {
+  typedef BigInteger<M> Integer;
+  typedef BigIntegerAccess A;
+
+  std::mt19937_64 rng(M);
+  std::size_t half = M / 2 > 0 ? M / 2 : 1;
+
+  // 加减法使用满位宽的操作数
+  Integer a = random_integer<M>(rng, M), b = random_integer<M>(rng, M);
+  // 乘法使用半位宽的操作数，使乘积恰好不被截断
+  Integer x = random_integer<M>(rng, half), y = random_integer<M>(rng, half);
+  // 除法使用 M 位除以 M / 2 位
+  Integer d = random_integer<M>(rng, half);
+  // 幂次使用满位宽的底数和 64 位的指数
+  Integer e = random_integer<M>(rng, M < 64 ? M : 64);
+  // 常数时间幂次的耗时与指数无关，与满位宽指数的普通实现对比
+  // 底数取奇数，避免偶数的幂很快变成 0；模幂使用 M 位的奇数模数
+  Integer c = (random_integer<M>(rng, M - 1) << 1) + 1, f = random_integer<M>(rng, M);
+  Integer n = (random_integer<M>(rng, M - 1) << 1) + 1;
+  std::string dec = a.dec(), hex = a.hex();
+  // 批量加减一次处理 64 组，与逐个相加对比
+  std::vector<Integer> as(64), bs(64), rs(64);
+  for (std::size_t i = 0; i < 64; ++i)
+    as[i] = random_integer<M>(rng, M), bs[i] = random_integer<M>(rng, M);
+  Integer a2 = a - 1;
+
+  run<M>("add", M, 1 << 20, [&] { sink += A::low_limb(A::add(a, b)); });
+  run<M>("sub", M, 1 << 20, [&] { sink += A::low_limb(A::sub(a, b)); });
+  run<M>("add_x64", M, 1 << 20, [&] {
+    for (std::size_t i = 0; i < 64; ++i) rs[i] = as[i] + bs[i];
+    sink += A::low_limb(rs[63]);
+  });
+  run<M>("add_batch_x64", M, 1 << 20, [&] { Integer::add_batch(as.data(), bs.data(), rs.data(), 64); sink += A::low_limb(rs[63]); });
+  BigIntegerBatch<M> as_batch(as), bs_batch(bs);
+  run<M>("batch_add_x64", M, 1 << 20, [&] { sink += A::low_limb(BigIntegerBatch<M>::add(as_batch, bs_batch).get(63)); });
+  run<M>("sub_batch_x64", M, 1 << 20, [&] { Integer::sub_batch(as.data(), bs.data(), rs.data(), 64); sink += A::low_limb(rs[63]); });
+  // 只有最低块不同，需要扫描全部的块
+  run<M>("compare", M, 1 << 20, [&] { sink += (a2 < a) + (a2 == a); });
+  run<M>("bit_and", M, 1 << 20, [&] { sink += A::low_limb(a & b); });
+  run<M>("bit_xor", M, 1 << 20, [&] { sink += A::low_limb(Integer::bit_xor(a, b)); });
+  run<M>("shift", M, 1 << 20, [&] { sink += A::low_limb((a << 77) >> 13); });
+  // 线性组合 3a - 2b + (a << 64) - f：逐步使用运算符与表达式模板一次遍历对比
+  run<M>("linear_combination", M, 1 << 20, [&] { sink += A::low_limb(a * 3 - b * 2 + (a << 64) - f); });
+  run<M>("linear_combination_lazy", M, 1 << 20, [&] { sink += A::low_limb((lazy(a) * 3 - lazy(b) * 2 + (lazy(a) << 64) - f).eval()); });
+  run<M>("mul_base", half, 1 << 20, [&] { sink += A::low_limb(A::mul_base(x, y)); });
+  run<M>("mul_karatsuba", half, 1 << 20, [&] { sink += A::low_limb(A::mul_karatsuba(x, y)); });
+  run<M>("mul_toom3", half, 1 << 20, [&] { sink += A::low_limb(A::mul_toom3(x, y)); });
+  run<M>("mul_toom4", half, 1 << 20, [&] { sink += A::low_limb(A::mul_toom4(x, y)); });
+  run<M>("mul_ntt", half, 1 << 20, [&] { sink += A::low_limb(A::mul_ntt(x, y)); });
+  run<M>("mul", half, 1 << 20, [&] { sink += A::low_limb(x * y); });
+  // 满位宽的乘法和平方只保留低 M 位，对比完整乘积后截断与短乘法
+  // 完整的 2M 位乘积：直接拷贝块与经过十六进制字符串转换对比
+  run<M>("mul_wide", M, 1 << 20, [&] { sink += A::low_limb(Integer::mul_wide(a, b)); });
+  run<M>("mul_wide_hex", M, 16384, [&] {
+    sink += A::low_limb(BigInteger<2 * M>::from_hex(a.hex()) * BigInteger<2 * M>::from_hex(b.hex()));
+  });
+  run<M>("mullo_base", M, 1 << 20, [&] { sink += A::low_limb(A::mul_base(a, b)); });
+  run<M>("mullo_karatsuba", M, 1 << 20, [&] { sink += A::low_limb(A::mul_karatsuba(a, b)); });
+  run<M>("mullo_short", M, 1 << 20, [&] { sink += A::low_limb(A::mul_short(a, b)); });
+  run<M>("mullo", M, 1 << 20, [&] { sink += A::low_limb(a * b); });
+  run<M>("sqrlo_karatsuba", M, 1 << 20, [&] { sink += A::low_limb(A::sqr_karatsuba_full(a)); });
+  run<M>("sqrlo_short", M, 1 << 20, [&] { sink += A::low_limb(A::sqr_short(a)); });
+  run<M>("sqrlo", M, 1 << 20, [&] { sink += A::low_limb(Integer::sqr(a)); });
+  run<M>("sqr_base", half, 1 << 20, [&] { sink += A::low_limb(A::sqr_base(x)); });
+  run<M>("sqr_karatsuba", half, 1 << 20, [&] { sink += A::low_limb(A::sqr_karatsuba(x)); });
+  run<M>("sqr", half, 1 << 20, [&] { sink += A::low_limb(Integer::sqr(x)); });
+  run<M>("div_base", M, 16384, [&] { sink += A::low_limb(A::div_base(a, d)); });
+  run<M>("div_binary_search", M, 4096, [&] { sink += A::low_limb(A::div_binary_search(a, d)); });
+  run<M>("div_knuth", M, 1 << 20, [&] { sink += A::low_limb(A::div_knuth(a, d)); });
+  run<M>("pow_base", M, 16384, [&] { sink += A::low_limb(A::pow_base(a, e)); });
+  run<M>("pow_packing", M, 16384, [&] { sink += A::low_limb(A::pow_packing(a, e)); });
+  run<M>("pow_sliding_window", M, 16384, [&] { sink += A::low_limb(A::pow_sliding_window(a, e)); });
+  run<M>("pow_base_full", M, 4096, [&] { sink += A::low_limb(A::pow_base(c, f)); });
+  run<M>("pow_ct", M, 4096, [&] { sink += A::low_limb(Integer::pow_ct(c, f)); });
+  MontgomeryContext<M> ctx(n);
+  run<M>("powmod", M, 4096, [&] { sink += A::low_limb(ctx.powmod(c, f)); });
+  run<M>("powmod_ct", M, 4096, [&] { sink += A::low_limb(ctx.powmod_ct(c, f)); });
+  // Barrett 约简：M 位数模 M / 2 位的 d 与直接取模对比，模乘和模幂与 Montgomery 对比
+  BarrettContext<M> bctx_d(d), bctx(n);
+  run<M>("mod", M, 1 << 20, [&] { sink += A::low_limb(a % d); });
+  run<M>("barrett_reduce", M, 1 << 20, [&] { sink += A::low_limb(bctx_d.reduce(a)); });
+  run<M>("mulmod", M, 16384, [&] { sink += A::low_limb(ctx.mulmod(a, b)); });
+  run<M>("barrett_mulmod", M, 16384, [&] { sink += A::low_limb(bctx.mulmod(a, b)); });
+  run<M>("barrett_powmod", M, 4096, [&] { sink += A::low_limb(bctx.powmod(c, f)); });
+  // 固定底数的幂只统计求值，表的大小约为 M * M / 4 位，因此只在较小的 M 下建表
+  std::unique_ptr<FixedBasePow<M>> fixed, fixed_mod;
+  if (options.full || M <= 4096)
+    fixed.reset(new FixedBasePow<M>(c)), fixed_mod.reset(new FixedBasePow<M>(c, ctx));
+  run<M>("fixed_base_pow", M, 4096, [&] { sink += A::low_limb(fixed->pow(f)); });
+  run<M>("fixed_base_powmod", M, 4096, [&] { sink += A::low_limb(fixed_mod->pow(f)); });
+  run<M>("fixed_base_build", M, 1024, [&] { sink += FixedBasePow<M>(c, ctx).table_size(); });
+  // 16 项的多重幂与逐项求幂再相乘对比
+  std::vector<Integer> ms(as.begin(), as.begin() + 16), mes(bs.begin(), bs.begin() + 16);
+  run<M>("pow_product_x16", M, 2048, [&] {
+    Integer r(1);
+    for (std::size_t i = 0; i < 16; ++i) r *= ms[i] ^ mes[i];
+    sink += A::low_limb(r);
+  });
+  run<M>("multi_pow_x16", M, 2048, [&] { sink += A::low_limb(Integer::multi_pow(ms, mes)); });
+  run<M>("powmod_product_x16", M, 2048, [&] {
+    Integer r(1);
+    for (std::size_t i = 0; i < 16; ++i) r = ctx.mulmod(r, ctx.powmod(ms[i], mes[i]));
+    sink += A::low_limb(r);
+  });
+  run<M>("multi_powmod_x16", M, 2048, [&] { sink += A::low_limb(ctx.multi_powmod(ms, mes)); });
+  // 同一个模数下的 64 次模乘和公钥指数 65537 的模幂（例如验证 RSA 签名），逐个计算与批量计算对比
+  std::vector<Integer> es(64, Integer(65537));
+  BigIntegerBatch<M> es_batch(es);
+  run<M>("mulmod_x64", M, 16384, [&] {
+    for (std::size_t i = 0; i < 64; ++i) rs[i] = ctx.mulmod(as[i], bs[i]);
+    sink += A::low_limb(rs[63]);
+  });
+  run<M>("batch_mulmod_x64", M, 16384, [&] { sink += A::low_limb(BigIntegerBatch<M>::mulmod(as_batch, bs_batch, ctx).get(63)); });
+  run<M>("powmod_x64", M, 16384, [&] {
+    for (std::size_t i = 0; i < 64; ++i) rs[i] = ctx.powmod(as[i], es[i]);
+    sink += A::low_limb(rs[63]);
+  });
+  run<M>("batch_powmod_x64", M, 16384, [&] { sink += A::low_limb(BigIntegerBatch<M>::powmod(as_batch, es_batch, ctx).get(63)); });
+  run<M>("to_dec", M, 1 << 20, [&] { sink += A::to_dec(a).size(); });
+  run<M>("from_dec", M, 1 << 20, [&] { sink += A::low_limb(Integer::from_dec(dec)); });
+  run<M>("to_hex", M, 1 << 20, [&] { sink += a.hex().size(); });
+  run<M>("from_hex", M, 1 << 20, [&] { sink += A::low_limb(Integer::from_hex(hex)); });
+  // 编译期常量只需要复制块，与运行期解析十六进制字符串对比
+  std::unique_ptr<BigIntegerLiteral<M>> literal(new BigIntegerLiteral<M>(("0x" + hex).c_str()));
+  run<M>("from_literal", M, 1 << 20, [&] { sink += A::low_limb(Integer(*literal)); });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 输出结果
+
+auto write_csv(std::ostream &os) -> void {
+  os << "operation,bits,operand_bits,limb_bits,iterations,ns_per_op\n";
+  for (auto &r : records) {
+    os << r.operation << ',' << r.bits << ',' << r.operand_bits << ',' << r.limb_bits << ','
+       << r.iterations << ',' << r.ns_per_op << '\n';
+  }
+}
+
+auto write_json(std::ostream &os) -> void {
+  os << "[\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    auto &r = records[i];
+    os << "  {\"operation\": \"" << r.operation << "\", \"bits\": " << r.bits
+       << ", \"operand_bits\": " << r.operand_bits << ", \"limb_bits\": " << r.limb_bits
+       << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op << "}"
+       << (i + 1 == records.size() ? "\n" : ",\n");
+  }
+  os << "]\n";
+}
+
+auto usage(const char *name) -> void {
+  std::cerr << "usage: " << name << " [--format csv|json] [--output FILE] [--filter NAME] [--min-time MS] [--full] [--simd scalar|avx2|avx512] [--threads N]\n";
+  std::exit(1);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--format" && i + 1 < argc) {
+      options.format = argv[++i];
+      if (options.format != "csv" && options.format != "json")
+        usage(argv[0]);
+    } else if (arg == "--output" && i + 1 < argc) {
+      options.output = argv[++i];
+    } else if (arg == "--filter" && i + 1 < argc) {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      options.min_time_ms = std::atof(argv[++i]);
+    } else if (arg == "--full") {
+      options.full = true;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      // 乘法并行模式使用的线程数，0 表示串行
+      ThreadPool::set_global_size((std::size_t)std::atoi(argv[++i]));
+    } else if (arg == "--simd" && i + 1 < argc) {
+      // 指定向量化内核的级别，便于与标量实现对比；超过 CPU 支持的级别时自动降级
+      std::string level = argv[++i];
+      if (level == "scalar") LimbSimd::set_level(LimbSimd::SCALAR);
+      else if (level == "avx2") LimbSimd::set_level(LimbSimd::AVX2);
+      else if (level == "avx512") LimbSimd::set_level(LimbSimd::AVX512);
+      else usage(argv[0]);
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  run_suite<64>();
+  run_suite<256>();
+  run_suite<1024>();
+  run_suite<4096>();
+  run_suite<16384>();
+  run_suite<65536>();
+  run_suite<262144>();
+
+  std::ofstream file;
+  if (!options.output.empty())
+    file.open(options.output);
+  std::ostream &os = options.output.empty() ? std::cout : file;
+
+  if (options.format == "json")
+    write_json(os);
+  else
+    write_csv(os);
+
+  return 0;
+}
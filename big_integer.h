@@ -12,71 +12,119 @@
 #include <cmath>
 #include <memory>
 #include <sstream>
+#include <iomanip>
+#include <utility>
+#include <vector>
 
-#include "list.h"
+#include "static_vector.h"
+#include "limb_simd.h"
+#include "thread_pool.h"
 
 // 实现模 2^M 意义下的大整数运算（正整数）
 template <std::size_t M>
 class BigInteger {
   static_assert(M != 0, "M == 0 is not allowed for template class BigInteger<M>");
 
- private: // 基本类型定义
+ private: // 基本类型定义：Limb 为一块（一个 2^LIMB_LEN 进制位），Integral 为两倍宽度的累加类型
+#if defined(__SIZEOF_INT128__) && !defined(FDS_BIG_INTEGER_32BIT_LIMB)
+  // x86-64 / AArch64 等 64 位平台：使用 64 位块，乘积放在 128 位整数中
+  typedef std::uint64_t Limb;
+  __extension__ typedef unsigned __int128 Integral;
+#else
+  // 可移植的后备实现：使用 32 位块，乘积放在 64 位整数中
+  typedef std::uint32_t Limb;
   typedef std::uint64_t Integral;
+#endif
+  static_assert(sizeof(Integral) == 2 * sizeof(Limb), "Integral must be twice as wide as Limb");
 
  private: // 为了让位运算更加直观，预先定义了一些常量
-  constexpr static Integral UNSIGNED_MAX = 1LL << 32;
-  constexpr static Integral UNSIGNED_MASK = 0xffffffff;
-  constexpr static Integral UNSIGNED_LEN = 32;
-  constexpr static Integral UNSIGNED_BIT_MASKS[32] = {
-      0xffffffff, 0x00000001, 0x00000003, 0x00000007,
-      0x0000000f, 0x0000001f, 0x0000003f, 0x0000007f,
-      0x000000ff, 0x000001ff, 0x000003ff, 0x000007ff,
-      0x00000fff, 0x00001fff, 0x00003fff, 0x00007fff,
-      0x0000ffff, 0x0001ffff, 0x0003ffff, 0x0007ffff,
-      0x000fffff, 0x001fffff, 0x003fffff, 0x007fffff,
-      0x00ffffff, 0x01ffffff, 0x03ffffff, 0x07ffffff,
-      0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff,
-  };
+  constexpr static std::size_t LIMB_LEN = sizeof(Limb) * 8;
+  constexpr static Integral LIMB_BASE = (Integral)1 << LIMB_LEN;
+  constexpr static Limb LIMB_MASK = ~(Limb)0;
 
- private: // 一些阈值
-  constexpr static Integral MUL_KARATSUBA_THRESHOLD = 20;
-  constexpr static Integral DIV_BINARY_SEARCH_THRESHOLD = 10;
-  constexpr static Integral POW_SLIDING_WINDOW_THRESHOLD = 50;
-  constexpr static Integral POW_PACKING_THRESHOLD = 30;
+ private: // 一些阈值（以块为单位）
+  constexpr static std::size_t MUL_KARATSUBA_THRESHOLD = 20;
+  constexpr static std::size_t MUL_TOOM3_THRESHOLD = 300; // 较短一方超过此规模时使用 Toom-3
+  constexpr static std::size_t MUL_TOOM4_THRESHOLD = 480; // 较短一方超过此规模时使用 Toom-4
+  constexpr static std::size_t MUL_NTT_THRESHOLD = LIMB_LEN == 64 ? 2500 : 800; // 较短一方超过此规模时使用 NTT
+  constexpr static std::size_t MUL_PARALLEL_THRESHOLD = 32768 / LIMB_LEN; // 超过 32768 位时把互相独立的子乘积交给全局线程池
+  constexpr static std::size_t SQR_BASE_THRESHOLD = 8; // 不超过此规模时平方直接使用朴素乘法
+  constexpr static std::size_t SQR_KARATSUBA_THRESHOLD = 64;
+  constexpr static std::size_t SQR_NTT_THRESHOLD = LIMB_LEN == 64 ? 4000 : 1000; // 平方的 Karatsuba 更快，NTT 的阈值也更高
+  constexpr static std::size_t MUL_SHORT_THRESHOLD = 128; // 只需要低 n 块时，n 不超过此值直接用截断的朴素乘法
+  constexpr static std::size_t POW_SLIDING_WINDOW_THRESHOLD = 50;
+  constexpr static std::size_t POW_PACKING_THRESHOLD = 30;
+  constexpr static std::size_t DEC_CONVERSION_THRESHOLD = 16; // 进制转换在此规模以下直接逐段计算
+  constexpr static std::size_t NARROW_THRESHOLD = 16384 / LIMB_LEN; // 超过 16384 位时分治乘法的子问题放进一半宽度的 Half 中计算
 
  private: // 操作常数
-  constexpr static Integral POW_SLIDING_WINDOW_LENGTH = 8;
-  constexpr static Integral POW_SLIDING_WINDOW_STORAGE_SIZE = 1ULL << POW_SLIDING_WINDOW_LENGTH;
-  constexpr static Integral POW_SLIDING_WINDOW_MASK = POW_SLIDING_WINDOW_STORAGE_SIZE - 1;
+  constexpr static std::size_t POW_SLIDING_WINDOW_LENGTH = 8;
+  constexpr static std::size_t POW_SLIDING_WINDOW_STORAGE_SIZE = 1ULL << POW_SLIDING_WINDOW_LENGTH;
+  constexpr static std::size_t POW_SLIDING_WINDOW_MASK = POW_SLIDING_WINDOW_STORAGE_SIZE - 1;
+
+  constexpr static std::size_t POW_PACKING_WINDOW_LENGTH = 8;
+  constexpr static std::size_t POW_PACKING_WINDOW_STORAGE_SIZE = 1ULL << POW_PACKING_WINDOW_LENGTH;
+  constexpr static std::size_t POW_PACKING_WINDOW_MASK = POW_PACKING_WINDOW_STORAGE_SIZE - 1;
+  static_assert(LIMB_LEN % POW_PACKING_WINDOW_LENGTH == 0, "a limb must hold whole packing windows");
+
+  constexpr static std::size_t MULTI_POW_STRAUS_MAX_WINDOW_LENGTH = 8;
+  constexpr static std::size_t MULTI_POW_PIPPENGER_MAX_WINDOW_LENGTH = 16;
+
+  constexpr static std::size_t POW_CT_WINDOW_LENGTH = 4;
+  constexpr static std::size_t POW_CT_TABLE_SIZE = 1ULL << POW_CT_WINDOW_LENGTH;
+  constexpr static std::size_t POW_CT_WINDOW_MASK = POW_CT_TABLE_SIZE - 1;
+  static_assert(LIMB_LEN % POW_CT_WINDOW_LENGTH == 0, "a limb must hold whole constant-time windows");
 
-  constexpr static Integral POW_PACKING_WINDOW_LENGTH = 8;
-  constexpr static Integral POW_PACKING_WINDOW_STORAGE_SIZE = 1ULL << POW_PACKING_WINDOW_LENGTH;
-  constexpr static Integral POW_PACKING_WINDOW_MASK = POW_PACKING_WINDOW_STORAGE_SIZE - 1;
+  // NTT 乘法使用的三个模数，均为 c * 2^k + 1 形式的素数且原根都是 3，乘积约为 2^86
+  // 每个系数取 32 位，卷积的每一项不超过 2^22 * (2^32 - 1)^2 < 2^86，可以用中国剩余定理精确还原
+  constexpr static std::uint32_t NTT_MOD0 = 998244353;  // 119 * 2^23 + 1
+  constexpr static std::uint32_t NTT_MOD1 = 167772161;  // 5 * 2^25 + 1
+  constexpr static std::uint32_t NTT_MOD2 = 469762049;  // 7 * 2^26 + 1
+  constexpr static std::uint32_t NTT_ROOT = 3;
+  constexpr static std::size_t NTT_MAX_LOG = 23; // 三个模数都支持的最大变换长度为 2^23
+  constexpr static std::size_t NTT_WORDS_PER_LIMB = LIMB_LEN / 32;
+
+  // 进制转换时每段十进制数字的位数，10^DEC_CHUNK_DIGITS 恰好能放进一块
+  constexpr static std::size_t DEC_CHUNK_DIGITS = LIMB_LEN == 64 ? 19 : 9;
+  constexpr static Limb DEC_CHUNK_BASE = LIMB_LEN == 64 ? (Limb)10000000000000000000ULL : (Limb)1000000000;
 
  private: // 取模辅助变量
-  constexpr static std::size_t LIMIT_NUMS = (M - 1) / 32 + 1; // 整块的个数
-  constexpr static std::size_t REM_BITS = M % 32; // 剩下的二进制位个数
+  constexpr static std::size_t LIMIT_NUMS = (M - 1) / LIMB_LEN + 1; // 整块的个数
+  constexpr static std::size_t REM_BITS = M % LIMB_LEN; // 剩下的二进制位个数
+  constexpr static Limb TOP_LIMB_MASK = REM_BITS == 0 ? LIMB_MASK : ((Limb)1 << REM_BITS) - 1; // 最高块保留的二进制位
+
+ private: // 约一半宽度的大整数：分治乘法的子问题放在 Half 中，栈上临时对象的大小随递归减半，而不是每层都占 M 位
+  // LIMIT_NUMS 不超过 NARROW_THRESHOLD 时 Half 就是 BigInteger<M> 本身，递归的模板实例化也在这里终止
+  constexpr static std::size_t HALF_BITS = LIMIT_NUMS > NARROW_THRESHOLD ? (LIMIT_NUMS / 2 + 4) * LIMB_LEN : M;
+  typedef BigInteger<HALF_BITS> Half;
+
+ private: // 底层存储：容量为 LIMIT_NUMS 的定长连续数组，低位在前
+  typedef StaticVector<Limb, LIMIT_NUMS> Storage;
 
  private: // 用于存储大整数数据
-  List<unsigned> data;
+  Storage data;
 
  public: // 构造函数与析构函数
   BigInteger();
   BigInteger(const BigInteger &other);
+  BigInteger(BigInteger &&other) noexcept;
   explicit BigInteger(const std::uint64_t &num);
   explicit BigInteger(const std::string &num);
   ~BigInteger();
 
- private: // 由链表构造大整数
-  explicit BigInteger(List<unsigned> &other);
+ private: // 由底层数组构造大整数
+  explicit BigInteger(Storage &other);
 
  public: // 拷贝与交换
   auto operator=(const BigInteger &other) -> BigInteger&;
+  auto operator=(BigInteger &&other) noexcept -> BigInteger&;
   auto swap(BigInteger &other) -> void;
   auto swap(BigInteger &&other) -> void;
 
- public: // 大整数加法运算符重载：直接调用加法辅助函数
-  auto operator+(const BigInteger &other) const -> BigInteger;
+ public: // 大整数加法运算符重载：直接调用加法辅助函数；左侧为右值时（例如 a * b + c）直接在它的存储上计算，不再构造新的结果
+
+  auto operator+(const BigInteger &other) const & -> BigInteger;
+  auto operator+(const BigInteger &other) && -> BigInteger;
   auto operator+(const std::uint64_t &other) const -> BigInteger;
   auto operator+(const std::string &other) const -> BigInteger;
   auto operator+=(const BigInteger &other) -> BigInteger&;
@@ -84,7 +132,8 @@ class BigInteger {
   auto operator+=(const std::string &other) -> BigInteger&;
 
  public: // 大整数减法运算符重载：直接调用减法辅助函数
-  auto operator-(const BigInteger &other) const -> BigInteger;
+  auto operator-(const BigInteger &other) const & -> BigInteger;
+  auto operator-(const BigInteger &other) && -> BigInteger;
   auto operator-(const std::uint64_t &other) const -> BigInteger;
   auto operator-(const std::string &other) const -> BigInteger;
   auto operator-=(const BigInteger &other) -> BigInteger&;
@@ -92,7 +141,8 @@ class BigInteger {
   auto operator-=(const std::string &other) -> BigInteger&;
 
  public: // 大整数乘法运算符重载：直接调用辅助函数
-  auto operator*(const BigInteger &other) const -> BigInteger;
+  auto operator*(const BigInteger &other) const & -> BigInteger;
+  auto operator*(const BigInteger &other) && -> BigInteger;
   auto operator*(const std::uint64_t &other) const -> BigInteger;
   auto operator*(const std::string &other) const -> BigInteger;
   auto operator*=(const BigInteger &other) -> BigInteger&;
@@ -107,6 +157,20 @@ class BigInteger {
   auto operator/=(const std::uint64_t &other) -> BigInteger&;
   auto operator/=(const std::string &other) -> BigInteger&;
 
+ public: // 大整数取模运算符重载：直接调用辅助函数
+  auto operator%(const BigInteger &other) const -> BigInteger;
+  auto operator%(const std::uint64_t &other) const -> BigInteger;
+  auto operator%(const std::string &other) const -> BigInteger;
+  auto operator%=(const BigInteger &other) -> BigInteger&;
+  auto operator%=(const std::uint64_t &other) -> BigInteger&;
+  auto operator%=(const std::string &other) -> BigInteger&;
+
+ public: // 带余除法：一次同时得到商和余数
+  static auto divmod(const BigInteger &a, const BigInteger &b) -> std::pair<BigInteger, BigInteger>;
+
+ public: // 平方：利用对称性只计算一半的交叉乘积，比一般的乘法更快
+  static auto sqr(const BigInteger &a) -> BigInteger;
+
  public: // 大整数幂次运算符重载：直接调用辅助函数
   auto operator^(const BigInteger &other) const -> BigInteger;
   auto operator^(const std::uint64_t &other) const -> BigInteger;
@@ -115,6 +179,57 @@ class BigInteger {
   auto operator^=(const std::uint64_t &other) -> BigInteger&;
   auto operator^=(const std::string &other) -> BigInteger&;
 
+ public: // 常数时间幂次：乘法次数和访存位置只与 M 有关，与指数的取值无关，用于指数需要保密的场合
+  // 注意：BigInteger 会去掉前导 0，读入指数时拷贝的块数仍然暴露了指数所占的块数，指数的最高块通常不为 0 时影响不大
+  static auto pow_ct(const BigInteger &a, const BigInteger &b) -> BigInteger;
+
+ public: // 宽度转换：直接在不同 M 的实例之间拷贝块，不经过字符串
+  template <std::size_t N>
+  auto widen() const -> BigInteger<N>; // 要求 N >= M，数值不变
+  template <std::size_t N>
+  auto narrow() const -> BigInteger<N>; // 要求 N <= M，结果为 this mod 2^N
+  auto low_half() const -> BigInteger<M / 2>; // 低 M / 2 位，要求 M 为偶数
+  auto high_half() const -> BigInteger<M / 2>; // 高 M / 2 位，要求 M 为偶数
+  static auto mul_wide(const BigInteger &a, const BigInteger &b) -> BigInteger<2 * M>; // 完整的 2M 位乘积，不会截断
+
+ public: // 多重幂：bases[0]^exps[0] * bases[1]^exps[1] * ...，所有项共用同一串平方，两个数组长度不同时 throw std::logic_error
+  static auto multi_pow(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps) -> BigInteger;
+
+ public: // 批量加减：out[i] = a[i] ± b[i]，共 count 组，内部转置后交给向量化内核同时处理多组，out 可以与 a、b 相同
+  static auto add_batch(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count) -> void;
+  static auto sub_batch(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count) -> void;
+
+ public: // 移位运算符重载：快速乘以或除以 2^count，复合赋值版本直接在原存储上移动
+  auto operator<<(std::size_t count) const & -> BigInteger;
+  auto operator<<(std::size_t count) && -> BigInteger;
+  auto operator>>(std::size_t count) const & -> BigInteger;
+  auto operator>>(std::size_t count) && -> BigInteger;
+  auto operator<<=(std::size_t count) -> BigInteger&;
+  auto operator>>=(std::size_t count) -> BigInteger&;
+
+ public: // 位运算：逐块一次完成，^ 已经用于幂次，所以异或只提供函数形式；取反针对全部 M 位
+  auto operator&(const BigInteger &other) const & -> BigInteger;
+  auto operator&(const BigInteger &other) && -> BigInteger;
+  auto operator&(const std::uint64_t &other) const -> BigInteger;
+  auto operator|(const BigInteger &other) const & -> BigInteger;
+  auto operator|(const BigInteger &other) && -> BigInteger;
+  auto operator|(const std::uint64_t &other) const -> BigInteger;
+  auto operator~() const -> BigInteger;
+  auto operator&=(const BigInteger &other) -> BigInteger&;
+  auto operator&=(const std::uint64_t &other) -> BigInteger&;
+  auto operator|=(const BigInteger &other) -> BigInteger&;
+  auto operator|=(const std::uint64_t &other) -> BigInteger&;
+  auto xor_assign(const BigInteger &other) -> BigInteger&; // *this = *this xor other
+  static auto bit_and(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto bit_or(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto bit_xor(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto bit_not(const BigInteger &a) -> BigInteger;
+
+ public: // 按位查询
+  auto bit_length() const -> std::size_t; // 最高的 1 所在位置加一，0 的长度为 0
+  auto popcount() const -> std::size_t; // 1 的个数
+  auto test_bit(std::size_t pos) const -> bool; // 第 pos 位是否为 1，pos 不小于 M 时为 false
+
  public: // 大整数判断是否相等运算符重载
   auto operator==(const BigInteger &other) const -> bool;
   auto operator==(const std::uint64_t &other) const -> bool;
@@ -141,6 +256,24 @@ class BigInteger {
   template <std::size_t N> friend auto operator>>(std::istream &is, BigInteger<N> &self) -> std::istream&;
   template <std::size_t N> friend auto operator<<(std::ostream &os, const BigInteger<N> &self) -> std::ostream&;
 
+ private: // 宽度转换需要访问其他实例的底层数组
+  template <std::size_t N> friend class BigInteger;
+
+ private: // 表达式模板通过 linear_combination 求值
+  template <std::size_t N, std::size_t K> friend class BigIntegerExpr;
+
+ private: // 编译期大整数与 BigInteger 使用相同的块，转换时直接复制
+  template <std::size_t N> friend class BigIntegerLiteral;
+
+ private: // 需要直接访问底层数组的模运算上下文、批量运算和固定底数的幂
+  template <std::size_t N> friend class MontgomeryContext;
+  template <std::size_t N> friend class BarrettContext;
+  template <std::size_t N> friend class BigIntegerBatch;
+  template <std::size_t N> friend class FixedBasePow;
+
+ private: // 测试和基准测试通过它直接调用内部算法
+  friend struct BigIntegerAccess;
+
  public: // 转换为对应进制的字符串
   auto hex() -> std::string;
   auto bin() -> std::string;
@@ -156,15 +289,77 @@ class BigInteger {
   static auto sub(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto mul(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto mul_base(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto mul_base_impl(const Limb *a, std::size_t n, const Limb *b, std::size_t m, Limb *out, std::size_t len) -> void;
   static auto mul_karatsuba(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto mul_karatsuba_impl(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  template <std::size_t N>
+  static auto mul_karatsuba_split(const BigInteger &a, const BigInteger &b) -> BigInteger; // 各段和三个子乘积都放在 BigInteger<N> 中，要求子乘积不会被 2^N 截断
+  static auto mul_full(const BigInteger &a, const BigInteger &b) -> BigInteger; // 根据规模选择计算完整乘积的算法
+  template <std::size_t N>
+  static auto mul_unbalanced(const BigInteger &a, const BigInteger &b) -> BigInteger; // a 比 b 长得多时按 b 的块数分段相乘，各段乘积放在 BigInteger<N> 中
+  static auto mul_toom3(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto mul_toom4(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  template <std::size_t N>
+  static auto mul_toom3_impl(const BigInteger &a, const BigInteger &b, std::size_t k) -> BigInteger; // 每段 k 块，各段、求值点和插值都放在 BigInteger<N> 中
+  template <std::size_t N>
+  static auto mul_toom4_impl(const BigInteger &a, const BigInteger &b, std::size_t k) -> BigInteger;
+  static auto mul_ntt(const BigInteger &a, const BigInteger &b) -> BigInteger; // 只计算低 LIMIT_NUMS 块，a 与 b 相同时只做一次正变换
+  static auto sqr_base(const BigInteger &a) -> BigInteger;
+  static auto sqr_base_impl(const Limb *a, std::size_t n, Limb *out, std::size_t len) -> void;
+  static auto sqr_karatsuba(const BigInteger &a) -> BigInteger;
+  template <std::size_t N>
+  static auto sqr_karatsuba_impl(const BigInteger &a) -> BigInteger; // 两半和三个子平方都放在 BigInteger<N> 中，要求子平方不会被 2^N 截断
+  static auto mul_short(const BigInteger &a, const BigInteger &b, std::size_t n) -> BigInteger; // 只计算乘积的低 n 块
+  static auto sqr_short(const BigInteger &a, std::size_t n) -> BigInteger; // 只计算平方的低 n 块
   static auto div(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto div_base(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto div_binary_search(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  static auto div_single_limb(const BigInteger &a, Limb b) -> std::pair<BigInteger, BigInteger>;
+  static auto div_knuth(const BigInteger &a, const BigInteger &b) -> std::pair<BigInteger, BigInteger>;
   static auto pow(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto pow_base(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto pow_packing(const BigInteger &a, const BigInteger &b) -> BigInteger;
   static auto pow_sliding_window(const BigInteger &a, const BigInteger &b) -> BigInteger;
+  template <class Mul, class Sqr> // 滑动窗口的通用实现，乘法和平方由 mul、sqr 给出，one 为乘法单位元
+  static auto pow_sliding_window_impl(const BigInteger &a, const BigInteger &b, const BigInteger &one, Mul mul, Sqr sqr) -> BigInteger;
+  template <class Mul, class Sqr> // 多重幂的通用实现，按估计的乘法次数在 Straus 和 Pippenger 之间选择算法和窗口长度
+  static auto multi_pow_impl(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr) -> BigInteger;
+  template <class Mul, class Sqr> // Straus：每项各自划分滑动窗口，所有项的窗口交错地乘进同一个结果
+  static auto multi_pow_straus(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr, std::size_t window) -> BigInteger;
+  template <class Mul, class Sqr> // Pippenger：每个固定窗口把取值相同的底数乘进同一个桶，再用后缀积合并各个桶
+  static auto multi_pow_pippenger(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr, std::size_t window) -> BigInteger;
+  auto bits_at(std::size_t pos, std::size_t len) const -> std::size_t; // 从第 pos 位开始的 len 位，len 不超过 16
+
+ private: // 并行辅助函数：size 超过 MUL_PARALLEL_THRESHOLD 且全局线程池有线程时并行执行 f...，否则依次执行
+  template <class... F>
+  static auto fork_join(std::size_t size, F&&... f) -> void;
+
+ private: // 原地运算辅助函数：结果直接写回 a 的存储，允许 a 与 b 是同一个对象
+  static auto add_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a + b
+  static auto sub_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a - b
+  static auto mul_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a * b
+  static auto shl_in_place(BigInteger &x, std::size_t count) -> void; // x = x * 2^count
+  static auto shr_in_place(BigInteger &x, std::size_t count) -> void; // x = x / 2^count
+  static auto and_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a and b
+  static auto or_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a or b
+  static auto xor_in_place(BigInteger &a, const BigInteger &b) -> void; // a = a xor b
+  static auto not_in_place(BigInteger &a) -> void; // a = 2^M - 1 - a
+
+ private: // 批量加减辅助函数
+  constexpr static std::size_t BATCH_GROUP_SIZE = 32; // 每次同时计算的组数
+  constexpr static std::size_t BATCH_BLOCK_SIZE = 32; // 每次转置的块数，缓冲区共 BATCH_GROUP_SIZE * BATCH_BLOCK_SIZE 块，可以放进 L1 缓存
+  static auto transpose_in(const Storage &v, std::size_t lo, std::size_t len, Limb *dst, std::size_t stride) -> void; // 第 [lo, lo + len) 块按 stride 间隔写出
+  static auto batch_impl(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count, bool subtract) -> void; // 分组转置后计算
+
+ private: // 线性组合辅助函数：计算 sum coefficient * (x << shift)，每一项原地累加、只遍历一遍，最后只截断一次，供表达式模板使用
+  struct LinearTerm {
+    const BigInteger *x;
+    std::int64_t coefficient;
+    std::size_t shift; // 左移的位数
+  };
+  static auto linear_combination(const LinearTerm *terms, std::size_t count) -> BigInteger;
+  template <std::size_t N>
+  static auto addmul_in_place(BigInteger &a, const BigInteger<N> &x, Limb c, std::size_t q, bool subtract) -> void; // a += c * (x << q 块)，subtract 时为 a -= c * (x << q 块)，x 可以是其他宽度
 
  private: // 大整数比较和判等辅助函数
   static auto equal(const BigInteger &a, const BigInteger &b) -> bool;
@@ -173,12 +368,32 @@ class BigInteger {
  private: // 其他辅助函数
   auto fix() -> void; // 快速取模和去除前导 0
   static auto shl(const BigInteger &x, std::size_t count) -> BigInteger; // 快速乘以 (2 ^ k), for any k
-  static auto shl_block(const BigInteger &x, std::size_t count) -> BigInteger; // 快速乘以 (2 ^ 32) ^ count
-  static auto shl_inside_block(const BigInteger &x, std::size_t count) -> BigInteger; // 快速乘以 (2 ^ k), k < 32
+  static auto shl_block(const BigInteger &x, std::size_t count) -> BigInteger; // 快速乘以 (2 ^ LIMB_LEN) ^ count
+  static auto shl_inside_block(const BigInteger &x, std::size_t count) -> BigInteger; // 快速乘以 (2 ^ k), k < LIMB_LEN
   static auto div_by_two(const BigInteger &x) -> BigInteger; // 快速除以 2
-  static auto decimal_to_binary(const std::string &s, List<unsigned> &list) -> void; // 将十进制数字（字符串类型）转成 2^32 进制（链表类型）
-  static auto binary_to_decimal(const List<unsigned> &list, std::string &s) -> void; // 将 2^32 进制（链表类型）转成十进制数字（字符串类型）
-  static auto decimal_add(std::string &a, std::string &b) -> std::string; // 将两个十进制数字（字符串类型）相加，用于辅助进制转换
+  static auto low_blocks(BigInteger &x, std::size_t n) -> void; // 只保留最低的 n 块，即对 (2 ^ LIMB_LEN) ^ n 取模
+  template <std::size_t N = M>
+  static auto slice(const BigInteger &x, std::size_t pos, std::size_t count) -> BigInteger<N>; // 取出 [pos, pos + count) 这几块，放进 BigInteger<N> 中
+  static auto sub_abs(const BigInteger &a, const BigInteger &b, BigInteger &result) -> bool; // result = |a - b|，返回 a < b
+  static auto div_exact_limb(BigInteger &x, Limb d) -> void; // 模 2^M 意义下除以奇数 d，即乘以 d 的逆元
+  static auto decimal_to_binary(const std::string &s, Storage &list) -> void; // 将十进制数字（字符串类型）转成 2^LIMB_LEN 进制（数组类型）
+  static auto binary_to_decimal(const Storage &list, std::string &s) -> void; // 将 2^LIMB_LEN 进制（数组类型）转成十进制数字（字符串类型）
+  static auto decimal_to_binary_impl(const char *s, std::size_t len) -> BigInteger; // 分治转换 s[0, len)
+  static auto binary_to_decimal_impl(const BigInteger &x, std::size_t level, std::size_t pad, std::string &s) -> void; // 分治转换并追加到 s 末尾
+  static auto decimal_powers() -> const std::vector<BigInteger>&; // 缓存的 10^(DEC_CHUNK_DIGITS * 2^t) mod 2^M
+  static auto mul_add_limb(BigInteger &x, Limb mul, Limb add) -> void; // x = x * mul + add
+
+ private: // 常数时间辅助函数：都在 n 块的定长数组上操作，没有与数据有关的分支和访存
+  static auto ct_sub(Limb *out, const Limb *a, const Limb *b, std::size_t n) -> Limb; // out = a - b，返回借位
+  static auto ct_select(Limb *out, const Limb *a, const Limb *b, std::size_t n, Limb flag) -> void; // out = flag ? a : b，flag 为 0 或 1
+  static auto ct_lookup(Limb *out, const Limb *table, std::size_t count, std::size_t n, std::size_t index) -> void; // out = table[index]，扫描整张表
+  static auto ct_mul_low(Limb *out, const Limb *a, const Limb *b, std::size_t n) -> void; // out = a * b 的低 n 块，out 不能与 a、b 重叠
+
+ private: // 数论变换辅助函数，P 为 NTT_MOD0、NTT_MOD1、NTT_MOD2 之一
+  template <std::uint32_t P> static auto pow_mod_word(std::uint32_t a, std::uint64_t e) -> std::uint32_t; // a ^ e mod P
+  template <std::uint32_t P> static auto ntt(std::vector<std::uint32_t> &a, bool invert) -> void; // 原地进行（逆）变换
+  template <std::uint32_t P> static auto ntt_convolve(const std::vector<std::uint32_t> &x, const std::vector<std::uint32_t> &y,
+                                                      std::size_t len, bool same) -> std::vector<std::uint32_t>; // 长度为 len 的循环卷积 mod P
 };
 
 #include "big_integer_impl.h"
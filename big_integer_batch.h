@@ -0,0 +1,66 @@
+#ifndef FDS_BIG_INTEGER_BATCH_
+#define FDS_BIG_INTEGER_BATCH_
+
+#include <vector>
+
+#include "big_integer.h"
+#include "montgomery.h"
+#include "limb_simd.h"
+
+// 批量大整数：同时保存 count 个 BigInteger<M>，对它们逐个做同一种运算
+// 采用“结构数组”布局，limbs[j * count + i] 为第 i 个数的第 j 块，每个数都占满 LIMIT_NUMS 块
+// 运算时最内层循环遍历各个数，互相独立的进位链交错执行，可以掩盖乘法的延迟，加减法直接使用 LimbSimd 的向量化内核
+// 模运算要求所有数使用同一个模数（例如验证同一个公钥下的大量签名），由 MontgomeryContext 给出
+template <std::size_t M>
+class BigIntegerBatch {
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef MontgomeryContext<M> Context;
+  typedef typename Integer::Limb Limb;
+  typedef typename Integer::Integral Integral;
+
+ private: // 常量
+  constexpr static std::size_t LIMB_LEN = Integer::LIMB_LEN;
+  constexpr static std::size_t LIMIT_NUMS = Integer::LIMIT_NUMS;
+  constexpr static std::size_t TILE_LANES = 64; // 乘法每次处理的数的个数，使工作区能放进缓存
+  constexpr static std::size_t POWMOD_WINDOW_LENGTH = 4; // 模幂的固定窗口长度
+  constexpr static std::size_t POWMOD_TABLE_SIZE = 1ULL << POWMOD_WINDOW_LENGTH;
+  constexpr static std::size_t POWMOD_SHORT_EXPONENT_BITS = 64; // 指数不超过此位数时使用长度为 1 的窗口
+  static_assert(LIMB_LEN % POWMOD_WINDOW_LENGTH == 0, "a limb must hold whole powmod windows");
+
+ private: // 数据
+  std::size_t count;
+  std::vector<Limb> limbs;
+
+ public: // 构造函数
+  explicit BigIntegerBatch(std::size_t count = 0); // count 个 0
+  explicit BigIntegerBatch(const std::vector<Integer> &values);
+
+ public: // 访问单个数
+  auto size() const -> std::size_t;
+  auto get(std::size_t i) const -> Integer;
+  auto set(std::size_t i, const Integer &x) -> void;
+  auto to_vector() const -> std::vector<Integer>;
+
+ public: // 模 2^M 意义下的运算，两个批量的大小必须相同
+  static auto add(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch;
+  static auto sub(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch;
+  static auto mul(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch;
+
+ public: // 模 ctx.modulus() 意义下的运算，输入可以是任意 [0, 2^M) 中的数
+  static auto mulmod(const BigIntegerBatch &a, const BigIntegerBatch &b, const Context &ctx) -> BigIntegerBatch; // a[i] * b[i] mod n
+  static auto powmod(const BigIntegerBatch &a, const BigIntegerBatch &e, const Context &ctx) -> BigIntegerBatch; // a[i] ^ e[i] mod n
+
+ private: // 辅助函数，通道数 lanes 都不超过 TILE_LANES，第 l 个数的第 j 块位于 x[j * stride + l]
+  static auto check_size(const BigIntegerBatch &a, const BigIntegerBatch &b) -> void;
+  static auto mask_top(BigIntegerBatch &x) -> void; // 截断最高块中超出 M 位的部分
+  static auto mul_lanes(const Limb *x, const Limb *y, Limb *out, std::size_t stride, std::size_t lanes, Limb *carry) -> void; // out = x * y mod 2^M，out 不能与 x、y 重叠
+  static auto mont_mul_lanes(const Context &ctx, const Limb *x, const Limb *y, Limb *out, std::size_t stride, std::size_t lanes, Limb *work) -> void; // out = x * y * R^{-1} mod n，out 可以与 x、y 相同
+  static auto load_tile(const BigIntegerBatch &a, std::size_t first, std::size_t lanes, const Context &ctx, Limb *out) -> void; // 取出 ctx.s 块，超出的数先对 n 取模
+  static auto broadcast(const Integer &x, std::size_t s, std::size_t lanes, Limb *out) -> void; // 每个通道都填入 x 的低 s 块
+  static auto store_tile(BigIntegerBatch &a, std::size_t first, std::size_t lanes, std::size_t s, const Limb *in) -> void;
+};
+
+#endif //FDS_BIG_INTEGER_BATCH_
+
+#include "big_integer_batch_impl.h"
@@ -0,0 +1,339 @@
+#ifndef FDS_BIG_INTEGER_BATCH_IMPL_
+#define FDS_BIG_INTEGER_BATCH_IMPL_
+
+#include "big_integer_batch.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// BigIntegerBatch 构造函数实现
+
+template<std::size_t M>
+BigIntegerBatch<M>::BigIntegerBatch(std::size_t count) : count(count), limbs(LIMIT_NUMS * count, 0) {}
+
+template<std::size_t M>
+BigIntegerBatch<M>::BigIntegerBatch(const std::vector<Integer> &values) : BigIntegerBatch(values.size()) {
+  for (std::size_t i = 0; i < count; ++i)
+    set(i, values[i]);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 访问单个数
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::size() const -> std::size_t { return count; }
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::get(std::size_t i) const -> Integer {
+  Integer result;
+  result.data.resize(LIMIT_NUMS, 0);
+  for (std::size_t j = 0; j < LIMIT_NUMS; ++j)
+    result.data[j] = limbs[j * count + i];
+  result.fix();
+  return result;
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::set(std::size_t i, const Integer &x) -> void {
+  for (std::size_t j = 0; j < LIMIT_NUMS; ++j)
+    limbs[j * count + i] = j < x.data.size() ? x.data[j] : 0;
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::to_vector() const -> std::vector<Integer> {
+  std::vector<Integer> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    result.push_back(get(i));
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模 2^M 意义下的加减法：整个批量一次交给向量化内核
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::add(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch {
+  check_size(a, b);
+  BigIntegerBatch result(a.count);
+  std::vector<Limb> carry(a.count, 0);
+  LimbSimd::add_lanes(a.limbs.data(), b.limbs.data(), result.limbs.data(), carry.data(), LIMIT_NUMS, a.count);
+  mask_top(result);
+  return result;
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::sub(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch {
+  check_size(a, b);
+  BigIntegerBatch result(a.count);
+  std::vector<Limb> carry(a.count, 0);
+  LimbSimd::sub_lanes(a.limbs.data(), b.limbs.data(), result.limbs.data(), carry.data(), LIMIT_NUMS, a.count);
+  mask_top(result);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模 2^M 意义下的乘法：每 TILE_LANES 个数一组计算截断的朴素乘法
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::mul(const BigIntegerBatch &a, const BigIntegerBatch &b) -> BigIntegerBatch {
+  check_size(a, b);
+  BigIntegerBatch result(a.count);
+  Limb carry[TILE_LANES];
+
+  for (std::size_t first = 0; first < a.count; first += TILE_LANES) {
+    std::size_t lanes = a.count - first < TILE_LANES ? a.count - first : TILE_LANES;
+    mul_lanes(a.limbs.data() + first, b.limbs.data() + first, result.limbs.data() + first, a.count, lanes, carry);
+  }
+
+  mask_top(result);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模乘：(a * R^2 * R^{-1}) * b * R^{-1} = a * b mod n
+// a、b 都小于 R 时满足 CIOS 的前提，不需要单独转换到 Montgomery 形式
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::mulmod(const BigIntegerBatch &a, const BigIntegerBatch &b, const Context &ctx) -> BigIntegerBatch {
+  check_size(a, b);
+  const std::size_t s = ctx.s;
+  BigIntegerBatch result(a.count);
+  std::vector<Limb> x(s * TILE_LANES), y(s * TILE_LANES), r2(s * TILE_LANES), work((s + 4) * TILE_LANES);
+
+  for (std::size_t first = 0; first < a.count; first += TILE_LANES) {
+    std::size_t lanes = a.count - first < TILE_LANES ? a.count - first : TILE_LANES;
+    load_tile(a, first, lanes, ctx, x.data());
+    load_tile(b, first, lanes, ctx, y.data());
+    broadcast(ctx.r2_mod, s, lanes, r2.data());
+
+    mont_mul_lanes(ctx, x.data(), r2.data(), x.data(), lanes, lanes, work.data());
+    mont_mul_lanes(ctx, x.data(), y.data(), x.data(), lanes, lanes, work.data());
+    store_tile(result, first, lanes, s, x.data());
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模幂：每 TILE_LANES 个数一组，在 Montgomery 形式下使用固定窗口
+// 同一组的数一起做平方，再各自按窗口取出表项相乘；窗口个数由这一组中最长的指数决定
+// 指数较短时（例如公钥指数 65537）预处理整张表反而更慢，改用长度为 1 的窗口；所有数的窗口都是 0 时省去这次乘法
+// 与 MontgomeryContext::powmod_ct 不同，耗时与指数有关，不适用于指数需要保密的场合
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::powmod(const BigIntegerBatch &a, const BigIntegerBatch &e, const Context &ctx) -> BigIntegerBatch {
+  check_size(a, e);
+  const std::size_t s = ctx.s, T = TILE_LANES;
+  BigIntegerBatch result(a.count);
+  std::vector<Limb> table(POWMOD_TABLE_SIZE * s * T), acc(s * T), entry(s * T), unit(s * T), work((s + 4) * T);
+
+  for (std::size_t first = 0; first < a.count; first += T) {
+    std::size_t lanes = a.count - first < T ? a.count - first : T;
+    const std::size_t span = s * lanes; // 一个表项占用的块数
+
+    // 这一组中最长的指数的位数
+    std::size_t bits = 0;
+    for (std::size_t j = LIMIT_NUMS; j > 0 && bits == 0; --j) {
+      Limb any = 0;
+      for (std::size_t l = 0; l < lanes; ++l)
+        any |= e.limbs[(j - 1) * e.count + first + l];
+      for (std::size_t k = LIMB_LEN; k > 0 && bits == 0; --k) {
+        if ((any >> (k - 1)) & 1)
+          bits = (j - 1) * LIMB_LEN + k;
+      }
+    }
+    const std::size_t W = bits <= POWMOD_SHORT_EXPONENT_BITS ? 1 : POWMOD_WINDOW_LENGTH, SIZE = (std::size_t)1 << W;
+
+    // 预处理 Montgomery 形式下的 a^0, a^1, ..., a^{2^w - 1}
+    broadcast(ctx.r_mod, s, lanes, &table[0]);
+    load_tile(a, first, lanes, ctx, &table[span]);
+    broadcast(ctx.r2_mod, s, lanes, unit.data());
+    mont_mul_lanes(ctx, &table[span], unit.data(), &table[span], lanes, lanes, work.data());
+    for (std::size_t k = 2; k < SIZE; ++k)
+      mont_mul_lanes(ctx, &table[(k - 1) * span], &table[span], &table[k * span], lanes, lanes, work.data());
+
+    std::copy(table.begin(), table.begin() + span, acc.begin());
+    bool started = false;
+    for (std::size_t pos = (bits + W - 1) / W * W; pos > 0; pos -= W) {
+      // 窗口 [pos - W, pos) 总是落在同一块中
+      const Limb *exp = &e.limbs[(pos - W) / LIMB_LEN * e.count + first];
+      const std::size_t shift = (pos - W) % LIMB_LEN;
+
+      if (started) {
+        for (std::size_t i = 0; i < W; ++i)
+          mont_mul_lanes(ctx, acc.data(), acc.data(), acc.data(), lanes, lanes, work.data());
+      }
+
+      // 各个数按自己的窗口取出表项
+      bool nonzero = false;
+      for (std::size_t l = 0; l < lanes; ++l) {
+        std::size_t digit = (std::size_t)(exp[l] >> shift) & (SIZE - 1);
+        const Limb *src = &table[digit * span + l];
+        for (std::size_t k = 0; k < s; ++k)
+          entry[k * lanes + l] = src[k * lanes];
+        nonzero |= digit != 0;
+      }
+      if (nonzero) {
+        mont_mul_lanes(ctx, acc.data(), entry.data(), acc.data(), lanes, lanes, work.data());
+        started = true;
+      }
+    }
+
+    // 转换回普通形式：乘以 1
+    broadcast(Integer(1), s, lanes, unit.data());
+    mont_mul_lanes(ctx, acc.data(), unit.data(), acc.data(), lanes, lanes, work.data());
+    store_tile(result, first, lanes, s, acc.data());
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 check_size、mask_top
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::check_size(const BigIntegerBatch &a, const BigIntegerBatch &b) -> void {
+  if (a.count != b.count)
+    throw std::logic_error("sizes of BigIntegerBatch operands do not match");
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::mask_top(BigIntegerBatch &x) -> void {
+  Limb *top = x.limbs.data() + (LIMIT_NUMS - 1) * x.count;
+  for (std::size_t i = 0; i < x.count; ++i)
+    top[i] &= Integer::TOP_LIMB_MASK;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_lanes
+// 按块的截断朴素乘法，只计算低 LIMIT_NUMS 块；对每一对 (i, j)，最内层循环遍历各个数
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::mul_lanes(const Limb *x, const Limb *y, Limb *out, std::size_t stride, std::size_t lanes, Limb *carry) -> void {
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    const Limb *xi = x + i * stride;
+    std::fill(carry, carry + lanes, 0);
+
+    for (std::size_t j = 0; i + j < LIMIT_NUMS; ++j) {
+      const Limb *yj = y + j * stride;
+      Limb *o = out + (i + j) * stride;
+      for (std::size_t l = 0; l < lanes; ++l) {
+        Integral cur = (Integral)xi[l] * yj[l] + o[l] + carry[l];
+        o[l] = (Limb)cur;
+        carry[l] = (Limb)(cur >> LIMB_LEN);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mont_mul_lanes
+// 与 MontgomeryContext::mont_mul_impl 相同的 CIOS，只是每一步都对 lanes 个数同时进行
+// work 至少需要 (s + 4) * lanes 块：t 占 s + 2 行，另外两行存放进位（借位）和 m
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::mont_mul_lanes(const Context &ctx, const Limb *x, const Limb *y, Limb *out, std::size_t stride, std::size_t lanes, Limb *work) -> void {
+  const std::size_t s = ctx.s;
+  const Limb *p = ctx.n.data.data(), n_prime = ctx.n_prime;
+  Limb *t = work, *carry = work + (s + 2) * lanes, *m = carry + lanes;
+  std::fill(t, t + (s + 2) * lanes, 0);
+
+  for (std::size_t i = 0; i < s; ++i) {
+    const Limb *yi = y + i * stride;
+    Limb *ts = t + s * lanes, *ts1 = ts + lanes, *prev = ts - lanes;
+
+    // t += a * b[i]
+    std::fill(carry, carry + lanes, 0);
+    for (std::size_t j = 0; j < s; ++j) {
+      const Limb *xj = x + j * stride;
+      Limb *tj = t + j * lanes;
+      for (std::size_t l = 0; l < lanes; ++l) {
+        Integral cur = (Integral)xj[l] * yi[l] + tj[l] + carry[l];
+        tj[l] = (Limb)cur;
+        carry[l] = (Limb)(cur >> LIMB_LEN);
+      }
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+      Integral cur = (Integral)ts[l] + carry[l];
+      ts[l] = (Limb)cur;
+      ts1[l] = (Limb)(cur >> LIMB_LEN);
+    }
+
+    // t = (t + m * n) / 2^LIMB_LEN，其中 m 使得最低块恰好为 0
+    for (std::size_t l = 0; l < lanes; ++l) {
+      m[l] = t[l] * n_prime;
+      carry[l] = (Limb)(((Integral)m[l] * p[0] + t[l]) >> LIMB_LEN);
+    }
+    for (std::size_t j = 1; j < s; ++j) {
+      Limb *tj = t + j * lanes, *prev = tj - lanes;
+      for (std::size_t l = 0; l < lanes; ++l) {
+        Integral cur = (Integral)m[l] * p[j] + tj[l] + carry[l];
+        prev[l] = (Limb)cur;
+        carry[l] = (Limb)(cur >> LIMB_LEN);
+      }
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+      Integral cur = (Integral)ts[l] + carry[l];
+      prev[l] = (Limb)cur;
+      ts[l] = ts1[l] + (Limb)(cur >> LIMB_LEN);
+    }
+  }
+
+  // 此时 t < 2n：先求出 t - n 的借位，t < n 时保留 t，否则减去 n
+  std::fill(carry, carry + lanes, 0);
+  for (std::size_t j = 0; j < s; ++j) {
+    const Limb *tj = t + j * lanes;
+    for (std::size_t l = 0; l < lanes; ++l)
+      carry[l] = (Limb)(((Integral)tj[l] - p[j] - carry[l]) >> LIMB_LEN) & 1;
+  }
+  for (std::size_t l = 0; l < lanes; ++l) {
+    m[l] = (Limb)0 - (~(carry[l] & ~t[s * lanes + l]) & 1); // 需要减去 n 时为全 1
+    carry[l] = 0;
+  }
+  for (std::size_t j = 0; j < s; ++j) {
+    const Limb *tj = t + j * lanes;
+    Limb *o = out + j * stride;
+    for (std::size_t l = 0; l < lanes; ++l) {
+      Integral cur = (Integral)tj[l] - (p[j] & m[l]) - carry[l];
+      o[l] = (Limb)cur;
+      carry[l] = (Limb)(cur >> LIMB_LEN) & 1;
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 load_tile、broadcast、store_tile
+// 在批量的存储和 s 行、lanes 列的工作区之间搬运数据
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::load_tile(const BigIntegerBatch &a, std::size_t first, std::size_t lanes, const Context &ctx, Limb *out) -> void {
+  const std::size_t s = ctx.s;
+  for (std::size_t j = 0; j < s; ++j)
+    std::copy(&a.limbs[j * a.count + first], &a.limbs[j * a.count + first] + lanes, out + j * lanes);
+
+  // 超过 s 块的数不满足 CIOS 的前提，先对 n 取模
+  for (std::size_t l = 0; l < lanes; ++l) {
+    bool high = false;
+    for (std::size_t j = s; j < LIMIT_NUMS && !high; ++j)
+      high = a.limbs[j * a.count + first + l] != 0;
+    if (high) {
+      Integer r = ctx.reduce(a.get(first + l));
+      for (std::size_t j = 0; j < s; ++j)
+        out[j * lanes + l] = j < r.data.size() ? r.data[j] : 0;
+    }
+  }
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::broadcast(const Integer &x, std::size_t s, std::size_t lanes, Limb *out) -> void {
+  for (std::size_t j = 0; j < s; ++j)
+    std::fill(out + j * lanes, out + (j + 1) * lanes, j < x.data.size() ? x.data[j] : 0);
+}
+
+template<std::size_t M>
+auto BigIntegerBatch<M>::store_tile(BigIntegerBatch &a, std::size_t first, std::size_t lanes, std::size_t s, const Limb *in) -> void {
+  for (std::size_t j = 0; j < s; ++j)
+    std::copy(in + j * lanes, in + (j + 1) * lanes, &a.limbs[j * a.count + first]);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_BIG_INTEGER_BATCH_IMPL_
@@ -0,0 +1,67 @@
+#ifndef FDS_BIG_INTEGER_EXPR_
+#define FDS_BIG_INTEGER_EXPR_
+
+#include <array>
+#include <cstdint>
+
+#include "big_integer.h"
+
+// 大整数的表达式模板（可选）：lazy(a) 把 a 包装成一个惰性表达式，之后的加减、乘以小整数和左移只记录各项，不做任何计算
+// 例如 lazy(a) * 3 - lazy(b) + (lazy(c) << 64) 在转换成 BigInteger<M> 或调用 eval() 时才求值
+// 求值时把每一项直接累加到同一个结果上，移位和乘以系数都在这一遍中完成，最后只截断一次；普通运算符每一步都要构造一个临时结果并完整遍历一遍
+// 表达式中的项数 N 是模板参数，各项放在定长数组中，构造表达式不需要分配内存
+// 注意：表达式只保存操作数的指针，操作数必须活到求值之后，不要用 auto 保存引用了临时对象的表达式（例如 auto e = lazy(a + b)）
+template <std::size_t M, std::size_t N>
+class BigIntegerExpr {
+  static_assert(N != 0, "an expression must have at least one term");
+
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef typename Integer::LinearTerm Term;
+
+ private: // 各项 coefficient * (x << shift)
+  std::array<Term, N> terms;
+
+ private: // 由各项构造表达式，只能通过 lazy() 和运算符得到
+  explicit BigIntegerExpr(const Integer &x); // 只有一项 1 * x，要求 N == 1
+  explicit BigIntegerExpr(const std::array<Term, N> &terms);
+  template <std::size_t N1, std::size_t K1> friend class BigIntegerExpr;
+  template <std::size_t N1> friend auto lazy(const BigInteger<N1> &x) -> BigIntegerExpr<N1, 1>;
+
+ public: // 求值
+  auto eval() const -> Integer;
+  operator Integer() const;
+
+ public: // 组合表达式
+  template <std::size_t K> auto operator+(const BigIntegerExpr<M, K> &other) const -> BigIntegerExpr<M, N + K>;
+  template <std::size_t K> auto operator-(const BigIntegerExpr<M, K> &other) const -> BigIntegerExpr<M, N + K>;
+  auto operator+(const Integer &other) const -> BigIntegerExpr<M, N + 1>;
+  auto operator-(const Integer &other) const -> BigIntegerExpr<M, N + 1>;
+  auto operator-() const -> BigIntegerExpr;
+
+ public: // 所有系数乘以 k，系数超出 std::int64_t 的范围时 throw std::logic_error
+  auto operator*(std::int64_t k) const -> BigIntegerExpr;
+
+ public: // 所有项左移 bits 位
+  auto operator<<(std::size_t bits) const -> BigIntegerExpr;
+
+ private: // 辅助函数
+  template <std::size_t K> auto concat(const BigIntegerExpr<M, K> &other, std::int64_t sign) const -> BigIntegerExpr<M, N + K>;
+  static auto scale(std::int64_t c, std::int64_t k) -> std::int64_t; // c * k，检查溢出
+};
+
+// 把大整数包装成只有一项的表达式
+template <std::size_t M>
+auto lazy(const BigInteger<M> &x) -> BigIntegerExpr<M, 1>;
+
+// 大整数或小整数在左侧的运算
+template <std::size_t M, std::size_t N>
+auto operator+(const BigInteger<M> &a, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N + 1>;
+template <std::size_t M, std::size_t N>
+auto operator-(const BigInteger<M> &a, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N + 1>;
+template <std::size_t M, std::size_t N>
+auto operator*(std::int64_t k, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N>;
+
+#endif //FDS_BIG_INTEGER_EXPR_
+
+#include "big_integer_expr_impl.h"
@@ -0,0 +1,124 @@
+#ifndef FDS_BIG_INTEGER_EXPR_IMPL_
+#define FDS_BIG_INTEGER_EXPR_IMPL_
+
+#include <limits>
+
+#include "big_integer_expr.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// BigIntegerExpr 构造函数实现
+
+template<std::size_t M, std::size_t N>
+BigIntegerExpr<M, N>::BigIntegerExpr(const Integer &x) : terms{{Term{&x, 1, 0}}} {
+  static_assert(N == 1, "only a single-term expression can be constructed from a BigInteger");
+}
+
+template<std::size_t M, std::size_t N>
+BigIntegerExpr<M, N>::BigIntegerExpr(const std::array<Term, N> &terms) : terms(terms) {}
+
+template<std::size_t M>
+auto lazy(const BigInteger<M> &x) -> BigIntegerExpr<M, 1> {
+  return BigIntegerExpr<M, 1>(x);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 求值
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::eval() const -> Integer {
+  return Integer::linear_combination(terms.data(), N);
+}
+
+template<std::size_t M, std::size_t N>
+BigIntegerExpr<M, N>::operator Integer() const { return eval(); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 组合表达式
+
+template<std::size_t M, std::size_t N>
+template<std::size_t K>
+auto BigIntegerExpr<M, N>::operator+(const BigIntegerExpr<M, K> &other) const -> BigIntegerExpr<M, N + K> {
+  return concat(other, 1);
+}
+
+template<std::size_t M, std::size_t N>
+template<std::size_t K>
+auto BigIntegerExpr<M, N>::operator-(const BigIntegerExpr<M, K> &other) const -> BigIntegerExpr<M, N + K> {
+  return concat(other, -1);
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::operator+(const Integer &other) const -> BigIntegerExpr<M, N + 1> {
+  return concat(lazy(other), 1);
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::operator-(const Integer &other) const -> BigIntegerExpr<M, N + 1> {
+  return concat(lazy(other), -1);
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::operator-() const -> BigIntegerExpr {
+  return *this * -1;
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::operator*(std::int64_t k) const -> BigIntegerExpr {
+  std::array<Term, N> result = terms;
+  for (Term &t : result)
+    t.coefficient = scale(t.coefficient, k);
+  return BigIntegerExpr(result);
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::operator<<(std::size_t bits) const -> BigIntegerExpr {
+  std::array<Term, N> result = terms;
+  for (Term &t : result)
+    t.shift = bits < M - t.shift ? t.shift + bits : M; // 左移 M 位及以上都是 0，避免 shift 溢出
+  return BigIntegerExpr(result);
+}
+
+template<std::size_t M, std::size_t N>
+auto operator+(const BigInteger<M> &a, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N + 1> {
+  return lazy(a) + b;
+}
+
+template<std::size_t M, std::size_t N>
+auto operator-(const BigInteger<M> &a, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N + 1> {
+  return lazy(a) - b;
+}
+
+template<std::size_t M, std::size_t N>
+auto operator*(std::int64_t k, const BigIntegerExpr<M, N> &b) -> BigIntegerExpr<M, N> {
+  return b * k;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 concat、scale
+
+template<std::size_t M, std::size_t N>
+template<std::size_t K>
+auto BigIntegerExpr<M, N>::concat(const BigIntegerExpr<M, K> &other, std::int64_t sign) const -> BigIntegerExpr<M, N + K> {
+  std::array<Term, N + K> result;
+  for (std::size_t i = 0; i < N; ++i)
+    result[i] = terms[i];
+  for (std::size_t i = 0; i < K; ++i) {
+    result[N + i] = other.terms[i];
+    result[N + i].coefficient = scale(other.terms[i].coefficient, sign);
+  }
+  return BigIntegerExpr<M, N + K>(result);
+}
+
+template<std::size_t M, std::size_t N>
+auto BigIntegerExpr<M, N>::scale(std::int64_t c, std::int64_t k) -> std::int64_t {
+  constexpr std::uint64_t limit = (std::uint64_t)std::numeric_limits<std::int64_t>::max();
+  std::uint64_t abs_c = c < 0 ? 0 - (std::uint64_t)c : (std::uint64_t)c;
+  std::uint64_t abs_k = k < 0 ? 0 - (std::uint64_t)k : (std::uint64_t)k;
+  if (abs_k != 0 && abs_c > limit / abs_k)
+    throw std::logic_error("coefficient of BigIntegerExpr is out of range");
+  return c * k;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_BIG_INTEGER_EXPR_IMPL_
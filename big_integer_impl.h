@@ -14,16 +14,17 @@ BigInteger<M>::BigInteger(const BigInteger &other) {
   data.reconstruct(other.data);
 }
 
+// 存储内嵌在对象中时移动等价于只复制有效的块，放在堆上时直接接管，other 变为 0
 template<std::size_t M>
-BigInteger<M>::BigInteger(const uint64_t &num) : data() {
-  unsigned high = num >> UNSIGNED_LEN & UNSIGNED_MASK;
-  unsigned low = num & UNSIGNED_MASK;
+BigInteger<M>::BigInteger(BigInteger &&other) noexcept : data(std::move(other.data)) {}
 
-  if (high != 0) {
-    data.push_back(low);
-    data.push_back(high);
-  } else if (low != 0) {
-    data.push_back(low);
+template<std::size_t M>
+BigInteger<M>::BigInteger(const uint64_t &num) : data() {
+  // 按块拆分，超出容量的高位本就会被取模截断
+  std::uint64_t rest = num;
+  for (std::size_t i = 0; i < LIMIT_NUMS && rest != 0; ++i) {
+    data.push_back((Limb)rest);
+    rest = (std::uint64_t)((Integral)rest >> LIMB_LEN);
   }
   this->fix();
 }
@@ -38,7 +39,7 @@ template<std::size_t M>
 BigInteger<M>::~BigInteger() = default;
 
 template<std::size_t M>
-BigInteger<M>::BigInteger(List<unsigned int> &other) {
+BigInteger<M>::BigInteger(Storage &other) {
   data.swap(other);
 }
 
@@ -51,6 +52,11 @@ auto BigInteger<M>::operator=(const BigInteger &other) -> BigInteger & {
   return *this;
 }
 template<std::size_t M>
+auto BigInteger<M>::operator=(BigInteger &&other) noexcept -> BigInteger & {
+  data = std::move(other.data);
+  return *this;
+}
+template<std::size_t M>
 auto BigInteger<M>::swap(BigInteger &other) -> void { data.swap(other.data); }
 
 template<std::size_t M>
@@ -62,49 +68,55 @@ auto BigInteger<M>::swap(BigInteger &&other) -> void {
 // 大整数加法运算符重载
 
 template<std::size_t M>
-auto BigInteger<M>::operator+(const BigInteger &other) const -> BigInteger { return add(*this, other); }
+auto BigInteger<M>::operator+(const BigInteger &other) const & -> BigInteger { return add(*this, other); }
+template<std::size_t M>
+auto BigInteger<M>::operator+(const BigInteger &other) && -> BigInteger { add_in_place(*this, other); return std::move(*this); }
 template<std::size_t M>
 auto BigInteger<M>::operator+(const uint64_t &other) const -> BigInteger { return add(*this, BigInteger(other)); }
 template<std::size_t M>
 auto BigInteger<M>::operator+(const std::string &other) const -> BigInteger { return add(*this, BigInteger(other)); }
 template<std::size_t M>
-auto BigInteger<M>::operator+=(const BigInteger &other) -> BigInteger& { return *this = add(*this, other); }
+auto BigInteger<M>::operator+=(const BigInteger &other) -> BigInteger& { add_in_place(*this, other); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator+=(const uint64_t &other) -> BigInteger& { return *this = add(*this, BigInteger(other)); }
+auto BigInteger<M>::operator+=(const uint64_t &other) -> BigInteger& { add_in_place(*this, BigInteger(other)); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator+=(const std::string &other) -> BigInteger& { return *this = add(*this, BigInteger(other)); }
+auto BigInteger<M>::operator+=(const std::string &other) -> BigInteger& { add_in_place(*this, BigInteger(other)); return *this; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 大整数减法运算符重载
 
 template<std::size_t M>
-auto BigInteger<M>::operator-(const BigInteger &other) const -> BigInteger { return sub(*this, other); }
+auto BigInteger<M>::operator-(const BigInteger &other) const & -> BigInteger { return sub(*this, other); }
+template<std::size_t M>
+auto BigInteger<M>::operator-(const BigInteger &other) && -> BigInteger { sub_in_place(*this, other); return std::move(*this); }
 template<std::size_t M>
 auto BigInteger<M>::operator-(const uint64_t &other) const -> BigInteger { return sub(*this, BigInteger(other)); }
 template<std::size_t M>
 auto BigInteger<M>::operator-(const std::string &other) const -> BigInteger { return sub(*this, BigInteger(other)); }
 template<std::size_t M>
-auto BigInteger<M>::operator-=(const BigInteger &other) -> BigInteger& { return *this = sub(*this, other); }
+auto BigInteger<M>::operator-=(const BigInteger &other) -> BigInteger& { sub_in_place(*this, other); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator-=(const uint64_t &other) -> BigInteger& { return *this = sub(*this, BigInteger(other)); }
+auto BigInteger<M>::operator-=(const uint64_t &other) -> BigInteger& { sub_in_place(*this, BigInteger(other)); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator-=(const std::string &other) -> BigInteger& { return *this = sub(*this, BigInteger(other)); }
+auto BigInteger<M>::operator-=(const std::string &other) -> BigInteger& { sub_in_place(*this, BigInteger(other)); return *this; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 大整数乘法运算符重载
 
 template<std::size_t M>
-auto BigInteger<M>::operator*(const BigInteger &other) const -> BigInteger { return mul(*this, other); }
+auto BigInteger<M>::operator*(const BigInteger &other) const & -> BigInteger { return mul(*this, other); }
+template<std::size_t M>
+auto BigInteger<M>::operator*(const BigInteger &other) && -> BigInteger { mul_in_place(*this, other); return std::move(*this); }
 template<std::size_t M>
 auto BigInteger<M>::operator*(const uint64_t &other) const -> BigInteger { return mul(*this, BigInteger(other)); }
 template<std::size_t M>
 auto BigInteger<M>::operator*(const std::string &other) const -> BigInteger { return mul(*this, BigInteger(other)); }
 template<std::size_t M>
-auto BigInteger<M>::operator*=(const BigInteger &other) -> BigInteger& { return *this = mul(*this, other); }
+auto BigInteger<M>::operator*=(const BigInteger &other) -> BigInteger& { mul_in_place(*this, other); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator*=(const uint64_t &other) -> BigInteger& { return *this = mul(*this, BigInteger(other)); }
+auto BigInteger<M>::operator*=(const uint64_t &other) -> BigInteger& { mul_in_place(*this, BigInteger(other)); return *this; }
 template<std::size_t M>
-auto BigInteger<M>::operator*=(const std::string &other) -> BigInteger& { return *this = mul(*this, BigInteger(other)); }
+auto BigInteger<M>::operator*=(const std::string &other) -> BigInteger& { mul_in_place(*this, BigInteger(other)); return *this; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 大整数除法运算符重载
@@ -122,6 +134,22 @@ auto BigInteger<M>::operator/=(const uint64_t &other) -> BigInteger & { return *
 template<std::size_t M>
 auto BigInteger<M>::operator/=(const std::string &other) -> BigInteger & { return *this = div(*this, BigInteger(other)); }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// 大整数取模运算符重载
+
+template<std::size_t M>
+auto BigInteger<M>::operator%(const BigInteger &other) const -> BigInteger { return divmod(*this, other).second; }
+template<std::size_t M>
+auto BigInteger<M>::operator%(const uint64_t &other) const -> BigInteger { return divmod(*this, BigInteger(other)).second; }
+template<std::size_t M>
+auto BigInteger<M>::operator%(const std::string &other) const -> BigInteger { return divmod(*this, BigInteger(other)).second; }
+template<std::size_t M>
+auto BigInteger<M>::operator%=(const BigInteger &other) -> BigInteger & { return *this = divmod(*this, other).second; }
+template<std::size_t M>
+auto BigInteger<M>::operator%=(const uint64_t &other) -> BigInteger & { return *this = divmod(*this, BigInteger(other)).second; }
+template<std::size_t M>
+auto BigInteger<M>::operator%=(const std::string &other) -> BigInteger & { return *this = divmod(*this, BigInteger(other)).second; }
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // 大整数幂次运算符重载
 
@@ -138,6 +166,112 @@ auto BigInteger<M>::operator^=(const uint64_t &other) -> BigInteger& { return *t
 template<std::size_t M>
 auto BigInteger<M>::operator^=(const std::string &other) -> BigInteger& { return *this = pow(*this, BigInteger(other)); }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// 移位运算符重载
+
+template<std::size_t M>
+auto BigInteger<M>::operator<<(std::size_t count) const & -> BigInteger { return shl(*this, count); }
+template<std::size_t M>
+auto BigInteger<M>::operator<<(std::size_t count) && -> BigInteger { shl_in_place(*this, count); return std::move(*this); }
+template<std::size_t M>
+auto BigInteger<M>::operator>>(std::size_t count) const & -> BigInteger {
+  BigInteger result(*this);
+  shr_in_place(result, count);
+  return result;
+}
+template<std::size_t M>
+auto BigInteger<M>::operator>>(std::size_t count) && -> BigInteger { shr_in_place(*this, count); return std::move(*this); }
+template<std::size_t M>
+auto BigInteger<M>::operator<<=(std::size_t count) -> BigInteger& { shl_in_place(*this, count); return *this; }
+template<std::size_t M>
+auto BigInteger<M>::operator>>=(std::size_t count) -> BigInteger& { shr_in_place(*this, count); return *this; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 位运算
+
+template<std::size_t M>
+auto BigInteger<M>::operator&(const BigInteger &other) const & -> BigInteger { return bit_and(*this, other); }
+template<std::size_t M>
+auto BigInteger<M>::operator&(const BigInteger &other) && -> BigInteger { and_in_place(*this, other); return std::move(*this); }
+template<std::size_t M>
+auto BigInteger<M>::operator&(const uint64_t &other) const -> BigInteger { return bit_and(*this, BigInteger(other)); }
+template<std::size_t M>
+auto BigInteger<M>::operator|(const BigInteger &other) const & -> BigInteger { return bit_or(*this, other); }
+template<std::size_t M>
+auto BigInteger<M>::operator|(const BigInteger &other) && -> BigInteger { or_in_place(*this, other); return std::move(*this); }
+template<std::size_t M>
+auto BigInteger<M>::operator|(const uint64_t &other) const -> BigInteger { return bit_or(*this, BigInteger(other)); }
+template<std::size_t M>
+auto BigInteger<M>::operator~() const -> BigInteger { return bit_not(*this); }
+template<std::size_t M>
+auto BigInteger<M>::operator&=(const BigInteger &other) -> BigInteger& { and_in_place(*this, other); return *this; }
+template<std::size_t M>
+auto BigInteger<M>::operator&=(const uint64_t &other) -> BigInteger& { and_in_place(*this, BigInteger(other)); return *this; }
+template<std::size_t M>
+auto BigInteger<M>::operator|=(const BigInteger &other) -> BigInteger& { or_in_place(*this, other); return *this; }
+template<std::size_t M>
+auto BigInteger<M>::operator|=(const uint64_t &other) -> BigInteger& { or_in_place(*this, BigInteger(other)); return *this; }
+template<std::size_t M>
+auto BigInteger<M>::xor_assign(const BigInteger &other) -> BigInteger& { xor_in_place(*this, other); return *this; }
+
+template<std::size_t M>
+auto BigInteger<M>::bit_and(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  // 结果不会比较短的一方长，从较短的一方复制
+  BigInteger result(a.data.size() <= b.data.size() ? a : b);
+  and_in_place(result, a.data.size() <= b.data.size() ? b : a);
+  return result;
+}
+template<std::size_t M>
+auto BigInteger<M>::bit_or(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  BigInteger result(a);
+  or_in_place(result, b);
+  return result;
+}
+template<std::size_t M>
+auto BigInteger<M>::bit_xor(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  BigInteger result(a);
+  xor_in_place(result, b);
+  return result;
+}
+template<std::size_t M>
+auto BigInteger<M>::bit_not(const BigInteger &a) -> BigInteger {
+  BigInteger result(a);
+  not_in_place(result);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 按位查询
+
+template<std::size_t M>
+auto BigInteger<M>::bit_length() const -> std::size_t {
+  if (data.empty())
+    return 0;
+  std::size_t bits = (data.size() - 1) * LIMB_LEN;
+  for (Limb top = data.back(); top; top >>= 1)
+    ++bits;
+  return bits;
+}
+
+template<std::size_t M>
+auto BigInteger<M>::popcount() const -> std::size_t {
+  std::size_t count = 0;
+  for (Limb x : data) {
+    // 每次消去最低的 1
+    for (; x; x &= x - 1)
+      ++count;
+  }
+  return count;
+}
+
+template<std::size_t M>
+auto BigInteger<M>::test_bit(std::size_t pos) const -> bool {
+  if (pos >= M)
+    return false;
+  std::size_t block = pos / LIMB_LEN;
+  return block < data.size() && ((data[block] >> (pos % LIMB_LEN)) & 1);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // 大整数比较运算符重载
 
@@ -207,11 +341,10 @@ auto BigInteger<M>::hex() -> std::string {
   this->fix();
   std::stringstream ss;
 
-  auto it = data.end();
-  do {
-    --it;
-    ss << std::hex << *it;
-  } while (it != data.begin());
+  // 每块固定输出 LIMB_LEN / 4 位，避免中间块的前导 0 丢失
+  for (std::size_t i = data.size(); i > 0; --i) {
+    ss << std::hex << std::setw(LIMB_LEN / 4) << std::setfill('0') << data[i - 1];
+  }
 
   std::string s;
   ss >> s;
@@ -239,13 +372,11 @@ auto BigInteger<M>::bin() -> std::string {
   this->fix();
   std::stringstream ss;
 
-  auto it = data.end();
-  do {
-    --it;
-    for (std::size_t j = 32; j > 0; --j) {
-      ss << (char)(((*it >> (j - 1)) & 1) + '0');
+  for (std::size_t i = data.size(); i > 0; --i) {
+    for (std::size_t j = LIMB_LEN; j > 0; --j) {
+      ss << (char)(((data[i - 1] >> (j - 1)) & 1) + '0');
     }
-  } while (it != data.begin());
+  }
 
   std::string s;
   ss >> s;
@@ -291,10 +422,10 @@ auto BigInteger<M>::from_hex(std::string s) -> BigInteger {
   for (auto &ch : s)
     ch = (char)std::tolower(ch);
 
-  for (std::size_t i = 0; i < s.length(); i += 8) {
-    std::string ss = s.substr(i, 8);
+  for (std::size_t i = 0; i < s.length(); i += LIMB_LEN / 4) {
+    std::string ss = s.substr(i, LIMB_LEN / 4);
 
-    Integral curr = 0;
+    Limb curr = 0;
     std::reverse(ss.begin(), ss.end());
     for (std::size_t j = 0; j < ss.length(); ++j) {
       if (std::isdigit(ss[j])) {
@@ -306,7 +437,9 @@ auto BigInteger<M>::from_hex(std::string s) -> BigInteger {
       }
     }
 
-    res.data.push_back(curr);
+    // 超出容量的高位会被取模截断，但仍需继续检查字符是否合法
+    if (res.data.size() < LIMIT_NUMS)
+      res.data.push_back(curr);
   }
 
   res.fix();
@@ -321,10 +454,10 @@ auto BigInteger<M>::from_bin(std::string s) -> BigInteger {
   BigInteger res;
   std::reverse(s.begin(), s.end());
 
-  for (std::size_t i = 0; i < s.length(); i += 32) {
-    std::string ss = s.substr(i, 32);
+  for (std::size_t i = 0; i < s.length(); i += LIMB_LEN) {
+    std::string ss = s.substr(i, LIMB_LEN);
 
-    Integral curr = 0;
+    Limb curr = 0;
     std::reverse(ss.begin(), ss.end());
     for (std::size_t j = 0; j < ss.length(); ++j) {
       if (ss[j] >= '0' && ss[j] <= '1') {
@@ -334,7 +467,9 @@ auto BigInteger<M>::from_bin(std::string s) -> BigInteger {
       }
     }
 
-    res.data.push_back(curr);
+    // 超出容量的高位会被取模截断，但仍需继续检查字符是否合法
+    if (res.data.size() < LIMIT_NUMS)
+      res.data.push_back(curr);
   }
 
   res.fix();
@@ -356,89 +491,319 @@ auto BigInteger<M>::from_dec(const std::string &s) -> BigInteger {
 
 template<std::size_t M>
 auto BigInteger<M>::add(const BigInteger &a, const BigInteger &b) -> BigInteger {
-  BigInteger res;
+  BigInteger result(a);
+  add_in_place(result, b);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 sub
+// 用于实现取模减法
+
+template<std::size_t M>
+auto BigInteger<M>::sub(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  BigInteger result(a);
+  sub_in_place(result, b);
+  return result;
+}
 
-  std::size_t len = std::max(a.data.size(), b.data.size());
-  auto it1 = a.data.begin(), it2 = b.data.begin();
-  Integral rem = 0, lhs, rhs;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 add_in_place
+// 原地加法：逐块相加写回 a，进位传播到 a 的高位，不构造新的大整数
 
-  // 设置上限，对于超出模数的部分直接不进行计算，可以减少运算量
-  for (std::size_t i = 0; i < len && res.data.size() < LIMIT_NUMS; ++i) {
-    lhs = it1 == a.data.end() ? 0 : *it1;
-    rhs = it2 == b.data.end() ? 0 : *it2;
-    rem += lhs + rhs;
+template<std::size_t M>
+auto BigInteger<M>::add_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t m = b.data.size();
+  if (a.data.size() < m)
+    a.data.resize(m, 0);
 
-    res.data.push_back(rem & UNSIGNED_MASK);
-    rem >>= UNSIGNED_LEN;
+  // 即使 a 与 b 是同一个对象，第 i 块也是先读后写，不会出错
+  Limb *p = a.data.data();
+  const Limb *q = b.data.data();
+  Limb carry = 0;
+  std::size_t i = 0;
 
-    if (it1 != a.data.end()) ++it1;
-    if (it2 != b.data.end()) ++it2;
+  for (; i < m; ++i) {
+    Integral cur = (Integral)p[i] + q[i] + carry;
+    p[i] = (Limb)cur;
+    carry = (Limb)(cur >> LIMB_LEN);
   }
+  for (; carry && i < a.data.size(); ++i)
+    carry = ++p[i] == 0;
+
+  // 超出上限的进位直接丢弃
+  if (carry && a.data.size() < LIMIT_NUMS)
+    a.data.push_back(1);
+
+  a.fix();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 sub_in_place
+// 原地减法：逐块相减写回 a
+
+template<std::size_t M>
+auto BigInteger<M>::sub_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t m = b.data.size();
+  if (a.data.size() < m)
+    a.data.resize(m, 0);
 
-  if (rem > 0) {
-    res.data.push_back(rem & UNSIGNED_MASK);
+  Limb *p = a.data.data();
+  const Limb *q = b.data.data();
+  Limb borrow = 0;
+  std::size_t i = 0;
+
+  for (; i < m; ++i) {
+    Integral cur = (Integral)p[i] - q[i] - borrow;
+    p[i] = (Limb)cur;
+    borrow = (Limb)(cur >> LIMB_LEN) & 1;
   }
+  for (; borrow && i < a.data.size(); ++i)
+    borrow = p[i]-- == 0;
 
-  res.fix();
-  return res;
+  // 如果被减数小于减数，则结果为 a + MOD - b，等价于把借位一直传播到最高块，再由 fix 截断
+  if (borrow)
+    a.data.resize(LIMIT_NUMS, (Limb)LIMB_MASK);
+
+  a.fix();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 sub
-// 用于实现取模减法
+// 批量加减 add_batch、sub_batch
 
 template<std::size_t M>
-auto BigInteger<M>::sub(const BigInteger &a, const BigInteger &b) -> BigInteger {
-  if (a < b) {
-    // 如果被减数小于减数，则结果为 a + MOD - b，等价于加上补码
-    BigInteger<M> rev;
-    rev.data.reconstruct(M, 0);
-
-    // 计算反码
-    for (auto it1 = rev.data.begin(), it2 = b.data.begin(); it1 != rev.data.end(); ++it1) {
-      if (it2 == b.data.end())
-        *it1 = UNSIGNED_MASK;
-      else
-        *it1 = UNSIGNED_MASK ^ *it2;
+auto BigInteger<M>::add_batch(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count) -> void {
+  batch_impl(a, b, out, count, false);
+}
 
-      if (it2 != b.data.end()) ++it2;
-    }
+template<std::size_t M>
+auto BigInteger<M>::sub_batch(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count) -> void {
+  batch_impl(a, b, out, count, true);
+}
 
-    if (!rev.data.empty())
-      rev.data.back() &= UNSIGNED_BIT_MASKS[REM_BITS];
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 transpose_in
+// 把 v 的第 [lo, lo + len) 块依次写到 dst[0], dst[stride], ...，超出 v 的部分补 0
 
-    // 计算补码
-    rev = rev + 1;
+template<std::size_t M>
+inline auto BigInteger<M>::transpose_in(const Storage &v, std::size_t lo, std::size_t len, Limb *dst, std::size_t stride) -> void {
+  std::size_t have = v.size() > lo ? v.size() - lo : 0;
+  if (have > len) have = len;
 
-    return a + rev;
-  } else {
-    BigInteger<M> result;
+  const Limb *src = v.data() + lo;
+  std::size_t j = 0;
+  for (; j < have; ++j)
+    dst[j * stride] = src[j];
+  for (; j < len; ++j)
+    dst[j * stride] = 0;
+}
 
-    // 如果被减数大于或等于减数，就直接减法
-    auto it1 = a.data.begin(), it2 = b.data.begin();
-    std::size_t len = std::max(a.data.size(), b.data.size());
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 batch_impl
+// 每 BATCH_GROUP_SIZE 组一起计算：每次把各组的 BATCH_BLOCK_SIZE 块转置成“结构数组”布局，
+// 交给 LimbSimd 的向量化内核，再转置回来，各组的进位保存在 carry 中传给下一段
+// 加法只需要处理到这一组中最长的数再多一块；减法的借位会传播到最高块，需要处理全部 LIMIT_NUMS 块
 
-    Integral lhs, rhs, minus = 0;
+template<std::size_t M>
+auto BigInteger<M>::batch_impl(const BigInteger *a, const BigInteger *b, BigInteger *out, std::size_t count, bool subtract) -> void {
+  Limb x[BATCH_GROUP_SIZE * BATCH_BLOCK_SIZE], y[BATCH_GROUP_SIZE * BATCH_BLOCK_SIZE], carry[BATCH_GROUP_SIZE];
 
-    for (std::size_t i = 0; i < len; ++i) {
-      lhs = it1 == a.data.end() ? 0 : *it1;
-      rhs = it2 == b.data.end() ? 0 : *it2;
+  for (std::size_t base = 0; base < count; base += BATCH_GROUP_SIZE) {
+    std::size_t lanes = count - base < BATCH_GROUP_SIZE ? count - base : BATCH_GROUP_SIZE;
 
-      // 由于减法会发生下溢出，因此写到右边去
-      if (lhs < rhs + minus) {
-        result.data.push_back(lhs + UNSIGNED_MAX - minus - rhs);
-        minus = 1;
-      } else {
-        result.data.push_back(lhs - minus - rhs);
-        minus = 0;
+    std::size_t n = LIMIT_NUMS;
+    if (!subtract) {
+      std::size_t longest = 0;
+      for (std::size_t i = 0; i < lanes; ++i) {
+        if (a[base + i].data.size() > longest) longest = a[base + i].data.size();
+        if (b[base + i].data.size() > longest) longest = b[base + i].data.size();
       }
+      if (longest < n) n = longest + 1;
+    }
 
-      if (it1 != a.data.end()) ++it1;
-      if (it2 != b.data.end()) ++it2;
+    // 先把结果扩展到 n 块；n 不小于 a、b 的块数，所以 out 与 a、b 相同时不会改变它们的值
+    for (std::size_t i = 0; i < lanes; ++i) {
+      BigInteger &r = out[base + i];
+      if (r.data.size() > n)
+        r.data.clear();
+      r.data.resize(n, 0);
+      carry[i] = 0;
     }
 
-    result.fix();
-    return result;
+    for (std::size_t lo = 0; lo < n; lo += BATCH_BLOCK_SIZE) {
+      std::size_t len = n - lo < BATCH_BLOCK_SIZE ? n - lo : BATCH_BLOCK_SIZE;
+
+      // 转置：x[j * lanes + i] 为第 i 组的第 lo + j 块，不足的高位补 0
+      for (std::size_t i = 0; i < lanes; ++i) {
+        transpose_in(a[base + i].data, lo, len, x + i, lanes);
+        transpose_in(b[base + i].data, lo, len, y + i, lanes);
+      }
+
+      if (subtract)
+        LimbSimd::sub_lanes(x, y, x, carry, len, lanes);
+      else
+        LimbSimd::add_lanes(x, y, x, carry, len, lanes);
+
+      // 这一段的输入已经全部读出，这时才写回，所以 out 可以与 a、b 相同
+      for (std::size_t i = 0; i < lanes; ++i) {
+        Limb *r = out[base + i].data.data() + lo;
+        for (std::size_t j = 0; j < len; ++j)
+          r[j] = x[j * lanes + i];
+      }
+    }
+
+    for (std::size_t i = 0; i < lanes; ++i)
+      out[base + i].fix();
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 and_in_place、or_in_place、xor_in_place、not_in_place
+// 原地位运算：逐块运算写回 a，允许 a 与 b 是同一个对象
+
+template<std::size_t M>
+auto BigInteger<M>::and_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t n = a.data.size(), m = b.data.size();
+  Limb *p = a.data.data();
+  const Limb *q = b.data.data();
+
+  // 超出 b 长度的部分全部变为 0，再由 fix 去掉前导 0
+  for (std::size_t i = 0; i < n; ++i)
+    p[i] = i < m ? p[i] & q[i] : 0;
+  a.fix();
+}
+
+template<std::size_t M>
+auto BigInteger<M>::or_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t m = b.data.size();
+  if (a.data.size() < m)
+    a.data.resize(m, 0);
+
+  // 两边的最高块都不为 0，结果不会产生前导 0
+  Limb *p = a.data.data();
+  const Limb *q = b.data.data();
+  for (std::size_t i = 0; i < m; ++i)
+    p[i] |= q[i];
+}
+
+template<std::size_t M>
+auto BigInteger<M>::xor_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t m = b.data.size();
+  if (a.data.size() < m)
+    a.data.resize(m, 0);
+
+  Limb *p = a.data.data();
+  const Limb *q = b.data.data();
+  for (std::size_t i = 0; i < m; ++i)
+    p[i] ^= q[i];
+  a.fix();
+}
+
+template<std::size_t M>
+auto BigInteger<M>::not_in_place(BigInteger &a) -> void {
+  a.data.resize(LIMIT_NUMS, 0);
+
+  // 补齐的高位块取反后全为 1，最高块多出来的位由 fix 截断
+  Limb *p = a.data.data();
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i)
+    p[i] = ~p[i];
+  a.fix();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_in_place
+// 原地乘法：朴素乘法的结果先写入栈上的临时数组再复制回 a，更大的规模交给 mul 选择算法
+
+template<std::size_t M>
+auto BigInteger<M>::mul_in_place(BigInteger &a, const BigInteger &b) -> void {
+  std::size_t n = a.data.size(), m = b.data.size();
+
+  if (&a == &b || (n > MUL_KARATSUBA_THRESHOLD && m > MUL_KARATSUBA_THRESHOLD)) {
+    a = mul(a, b);
+    return;
+  }
+
+  Limb scratch[LIMIT_NUMS];
+  std::size_t len = n + m < LIMIT_NUMS ? n + m : LIMIT_NUMS;
+  std::fill(scratch, scratch + len, 0);
+  mul_base_impl(a.data.data(), n, b.data.data(), m, scratch, len);
+
+  a.data.resize(len, 0);
+  std::copy(scratch, scratch + len, a.data.begin());
+  a.fix();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 shl_in_place
+// 原地左移 count 位：从高到低写入，每一块只依赖原来更低（或相同）位置的块，不会被提前覆盖
+
+template<std::size_t M>
+auto BigInteger<M>::shl_in_place(BigInteger &x, std::size_t count) -> void {
+  std::size_t blocks = count / LIMB_LEN, bits = count % LIMB_LEN, n = x.data.size();
+  if (n == 0 || count == 0)
+    return;
+  if (blocks >= LIMIT_NUMS) {
+    x.data.clear();
+    return;
+  }
+
+  // 块内移位可能多出一块，超出上限的部分直接丢弃
+  std::size_t len = n + blocks + (bits != 0);
+  if (len > LIMIT_NUMS)
+    len = LIMIT_NUMS;
+  x.data.resize(len, 0);
+
+  Limb *p = x.data.data();
+  for (std::size_t i = len; i > blocks; --i) {
+    std::size_t src = i - 1 - blocks;
+    if (bits == 0)
+      p[i - 1] = p[src];
+    else
+      p[i - 1] = (p[src] << bits) | (src > 0 ? p[src - 1] >> (LIMB_LEN - bits) : 0);
+  }
+  std::fill(p, p + blocks, 0);
+
+  x.fix();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 shr_in_place
+// 原地右移 count 位：从低到高写入，每一块只依赖原来更高（或相同）位置的块
+
+template<std::size_t M>
+auto BigInteger<M>::shr_in_place(BigInteger &x, std::size_t count) -> void {
+  std::size_t blocks = count / LIMB_LEN, bits = count % LIMB_LEN, n = x.data.size();
+  if (blocks >= n) {
+    x.data.clear();
+    return;
+  }
+
+  Limb *p = x.data.data();
+  for (std::size_t i = 0; i + blocks < n; ++i) {
+    if (bits == 0)
+      p[i] = p[i + blocks];
+    else
+      p[i] = (p[i + blocks] >> bits) | (i + blocks + 1 < n ? p[i + blocks + 1] << (LIMB_LEN - bits) : 0);
+  }
+  // 高处空出的块清零，由 fix 一并去掉
+  std::fill(p + (n - blocks), p + n, 0);
+
+  x.fix();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 fork_join
+// 分治乘法中互相独立的子乘积在规模足够大时交给全局线程池，否则（包括线程池没有线程时）按顺序执行
+
+template<std::size_t M>
+template<class... F>
+auto BigInteger<M>::fork_join(std::size_t size, F&&... f) -> void {
+  ThreadPool &pool = ThreadPool::global();
+  if (size > MUL_PARALLEL_THRESHOLD && pool.size() > 0) {
+    pool.invoke(std::forward<F>(f)...);
+  } else {
+    int expand[] = {(f(), 0)...};
+    (void)expand;
   }
 }
 
@@ -450,11 +815,20 @@ template<std::size_t M>
 inline auto BigInteger<M>::mul(const BigInteger &a, const BigInteger &b) -> BigInteger {
   std::size_t n = a.data.size(), m = b.data.size();
 
-  // 事实上，Karatsuba 是一种很容易推广的算法，例如如果分成四段，可以得到时间复杂度为 O(n^{log{7}/log{4}}) 的做法
-  // 但是，作为课程设计，此处只是说明原理的可行性，故没有针对更多的数据规模进行细分采用不同的数据规模处理
+  // 两个操作数是同一个对象时（例如 x * x），改用平方
+  if (&a == &b)
+    return sqr(a);
+
+  // 规模从小到大依次使用朴素乘法、Karatsuba、Toom-3 和 Toom-4，具体的选择见 mul_full
   // 当 N 足够大时，FFT 的优势就体现出来了，但一般 N 至少要到 5000 量级，这意味着除非我们的模数是 2^16000 量级，FFT 才会比 TOOM-8H 有明显优势
   if (n > MUL_KARATSUBA_THRESHOLD && m > MUL_KARATSUBA_THRESHOLD) {
-    return mul_karatsuba(a, b);
+    // 规模很大时 NTT 最快，它的代价只取决于变换长度，截断与否都直接计算
+    if (n > MUL_NTT_THRESHOLD && m > MUL_NTT_THRESHOLD)
+      return mul_ntt(a, b);
+    // 乘积超过 LIMIT_NUMS 块时高位会被截断，只计算保留下来的低位部分
+    if (n + m > LIMIT_NUMS)
+      return mul_short(a, b, LIMIT_NUMS);
+    return mul_full(a, b);
   } else {
     return mul_base(a, b);
   }
@@ -467,39 +841,39 @@ inline auto BigInteger<M>::mul(const BigInteger &a, const BigInteger &b) -> BigI
 template<std::size_t M>
 auto BigInteger<M>::mul_base(const BigInteger &a, const BigInteger &b) -> BigInteger {
   BigInteger result;
-  auto it2 = b.data.begin();
-  std::size_t cnt = 0;
+  std::size_t n = a.data.size(), m = b.data.size();
+
+  // 结果最多 n + m 块，超出上限的部分直接不进行计算
+  std::size_t len = n + m < LIMIT_NUMS ? n + m : LIMIT_NUMS;
+  result.data.resize(len, 0);
+  mul_base_impl(a.data.data(), n, b.data.data(), m, result.data.data(), len);
 
-  // 枚举其中一个链表中的元素，然后遍历另一个链表，将乘法转化为加法
-  while (it2 != b.data.end()) {
-    BigInteger tmp;
-    tmp.data.reconstruct(cnt, 0);
+  result.fix();
+  return result;
+}
 
-    Integral rem = 0, cur0, cur1;
-    auto it1 = a.data.begin();
-    for (; it1 != a.data.end() && tmp.data.size() < LIMIT_NUMS; ++it1) {
-      // 防止溢出 unsigned long long，先乘再进位
-      cur0 = 1ULL * (*it2) * (*it1);
-      cur1 = cur0 & UNSIGNED_MASK;
-      cur0 >>= UNSIGNED_LEN;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_base_impl
+// 朴素乘法的核心循环，把 a * b 的低 len 块累加到 out 中（调用前 out 需要清零），out 不能与 a、b 重叠
 
-      cur1 += rem;
-      cur0 += cur1 >> UNSIGNED_LEN;
-      cur1 &= UNSIGNED_MASK;
+template<std::size_t M>
+auto BigInteger<M>::mul_base_impl(const Limb *a, std::size_t n, const Limb *b, std::size_t m, Limb *out, std::size_t len) -> void {
+  // 枚举其中一个数组中的元素，然后遍历另一个数组，直接累加到结果的对应位置上
+  for (std::size_t i = 0; i < m && i < len; ++i) {
+    Integral rem = 0, cur;
+    std::size_t j = 0;
 
-      tmp.data.push_back(cur1);
-      rem = cur0;
+    for (; j < n && i + j < len; ++j) {
+      // (2^w - 1)^2 + 2 * (2^w - 1) 恰好不会溢出两倍宽度的 Integral
+      cur = (Integral)b[i] * a[j] + out[i + j] + rem;
+      out[i + j] = (Limb)cur;
+      rem = cur >> LIMB_LEN;
     }
 
-    if (rem > 0) {
-      tmp.data.push_back(rem);
+    if (i + j < len) {
+      out[i + j] = (Limb)rem;
     }
-    result += tmp;
-    ++cnt, ++it2;
   }
-
-  result.fix();
-  return result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -516,6 +890,7 @@ auto BigInteger<M>::mul_karatsuba(const BigInteger &a, const BigInteger &b) -> B
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 mul_karatsuba_impl
 // Karatsuba 主要过程（分治）
+// 与 sqr_karatsuba 相同，乘积能放进 Half 时整体交给 Half，否则各段和三个子乘积只要不会被截断就放进 Half
 
 template<std::size_t M>
 auto BigInteger<M>::mul_karatsuba_impl(const BigInteger &a, const BigInteger &b) -> BigInteger {
@@ -531,102 +906,881 @@ auto BigInteger<M>::mul_karatsuba_impl(const BigInteger &a, const BigInteger &b)
     return BigInteger(0);
   }
 
-  std::size_t mx = std::max(n, m);
+  if (HALF_BITS < M && n + m <= Half::LIMIT_NUMS)
+    return Half::mul_karatsuba_impl(a.template narrow<HALF_BITS>(), b.template narrow<HALF_BITS>()).template widen<M>();
+
+  // 最长的子乘积是 (A + B)(C + D)，两边长度不等时较短的一方可能整个落在低半部分
+  std::size_t half = std::max(n, m) / 2;
+  std::size_t sa = n > half ? std::max(n - half, half) : n, sb = m > half ? std::max(m - half, half) : m;
+  if (sa + sb + 2 <= Half::LIMIT_NUMS)
+    return mul_karatsuba_split<HALF_BITS>(a, b);
+  return mul_karatsuba_split<M>(a, b);
+}
 
-  // 链表分裂
-  auto ab = a.data.split(mx / 2);
-  auto cd = b.data.split(mx / 2);
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::mul_karatsuba_split(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  typedef BigInteger<N> Part;
+  std::size_t n = a.data.size(), m = b.data.size();
+  std::size_t mx = std::max(n, m), half = mx / 2;
 
-  BigInteger A(ab.second), C(cd.second), B(ab.first), D(cd.first);
-  BigInteger AC, BD, ABCD;
+  // 数组分裂
+  Part A = slice<N>(a, half, mx - half), C = slice<N>(b, half, mx - half), B = slice<N>(a, 0, half), D = slice<N>(b, 0, half);
+  Part AB = A + B, CD = C + D;
 
-  // 通过分治得到三个局部结果
-  AC.swap(mul_karatsuba_impl(A, C));
-  BD.swap(mul_karatsuba_impl(B, D));
-  ABCD.swap(mul_karatsuba_impl(A + B, C + D));
+  // 通过分治得到三个局部结果，规模足够大时并行计算
+  Part AC, BD, ABCD;
+  fork_join(n < m ? n : m,
+            [&] { AC = Part::mul_karatsuba_impl(A, C); },
+            [&] { BD = Part::mul_karatsuba_impl(B, D); },
+            [&] { ABCD = Part::mul_karatsuba_impl(AB, CD); });
 
   // 利用局部结果计算乘积
-  return shl_block(AC, mx / 2 * 2) + shl_block(ABCD - AC - BD, mx / 2) + BD;
+  ABCD -= AC, ABCD -= BD;
+  BigInteger result = BD.template widen<M>();
+  addmul_in_place(result, ABCD, 1, half, false);
+  addmul_in_place(result, AC, 1, half * 2, false);
+  result.fix();
+  return result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 div
-// 调用除法的实现，并排除平凡情况
+// 平方 sqr
+// 根据规模选择朴素平方或 Karatsuba 平方
 
 template<std::size_t M>
-auto BigInteger<M>::div(const BigInteger &a, const BigInteger &b) -> BigInteger {
-  // 对于比较平凡的情况进行特判
-  if (b.data.empty())
-    throw std::logic_error("division by zero");
+auto BigInteger<M>::sqr(const BigInteger &a) -> BigInteger {
+  std::size_t n = a.data.size();
 
-  if (a.data.empty() || a < b)
-    return BigInteger(0);
+  // 规模很大时使用 NTT，只需要对 a 做一次正变换
+  if (n > SQR_NTT_THRESHOLD)
+    return mul_ntt(a, a);
+  if (n > SQR_KARATSUBA_THRESHOLD) {
+    // 与乘法相同，结果会被截断时只计算低位部分
+    if (2 * n > LIMIT_NUMS)
+      return sqr_short(a, LIMIT_NUMS);
+    return sqr_karatsuba(a);
+  }
+  return sqr_base(a);
+}
 
-  std::size_t n = a.data.size(), m = b.data.size();
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 sqr_base
+// 朴素平方
 
-  // 如果小于二分阈值，则调用朴素除法
-  if (n < DIV_BINARY_SEARCH_THRESHOLD && m < DIV_BINARY_SEARCH_THRESHOLD)
-    return div_base(a, b);
+template<std::size_t M>
+auto BigInteger<M>::sqr_base(const BigInteger &a) -> BigInteger {
+  BigInteger result;
+  std::size_t n = a.data.size();
+
+  // 结果最多 2n 块，超出上限的部分直接不进行计算
+  std::size_t len = 2 * n < LIMIT_NUMS ? 2 * n : LIMIT_NUMS;
+  result.data.resize(len, 0);
+
+  // 规模很小时，乘 2 和加对角线的额外遍历抵消了省下的乘法
+  if (n <= SQR_BASE_THRESHOLD)
+    mul_base_impl(a.data.data(), n, a.data.data(), n, result.data.data(), len);
+  else
+    sqr_base_impl(a.data.data(), n, result.data.data(), len);
 
-  // 调用二分除法
-  return div_binary_search(a, b);
+  result.fix();
+  return result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 div_base
-// 转换乘减法的除法
+// 辅助函数 sqr_base_impl
+// 朴素平方的核心循环，把 a^2 的低 len 块写入 out 中（调用前 out 需要清零，且 len <= 2n），out 不能与 a 重叠
+// a[i] * a[j] 与 a[j] * a[i] 相同，所以只计算 i < j 的一半交叉乘积，整体乘 2 后再加上对角线 a[i]^2
 
 template<std::size_t M>
-auto BigInteger<M>::div_base(const BigInteger &a, const BigInteger &b) -> BigInteger {
-  BigInteger mod = a, div;
-
-  for (std::size_t i = a.data.size(); i > 0; --i) {
-    Integral res = 0;
+auto BigInteger<M>::sqr_base_impl(const Limb *a, std::size_t n, Limb *out, std::size_t len) -> void {
+  // 第一步：累加 i < j 的交叉乘积，与朴素乘法相同，第 i 行写到的最高位置 i + n 此前没有被写过
+  for (std::size_t i = 0; i < n && 2 * i + 1 < len; ++i) {
+    Integral rem = 0, cur;
+    std::size_t j = i + 1;
 
-    // 枚举 2^k * b 是否能被减去，能减去就减去
-    for (std::size_t j = UNSIGNED_LEN; j > 0; --j) {
-      BigInteger tmp(shl_inside_block(shl_block(b, i - 1), j - 1));
+    for (; j < n && i + j < len; ++j) {
+      cur = (Integral)a[i] * a[j] + out[i + j] + rem;
+      out[i + j] = (Limb)cur;
+      rem = cur >> LIMB_LEN;
+    }
 
-      if (mod >= tmp) {
-        mod -= tmp;
-        res |= (1 << (j - 1));
-      }
+    if (i + j < len) {
+      out[i + j] = (Limb)rem;
     }
+  }
 
-    div.data.push_front(res);
+  // 第二步：整体乘 2，超出 len 的最高位直接丢弃
+  Limb top = 0;
+  for (std::size_t k = 0; k < len; ++k) {
+    Limb next = out[k] >> (LIMB_LEN - 1);
+    out[k] = (out[k] << 1) | top;
+    top = next;
   }
 
-  div.fix();
-  return div;
+  // 第三步：加上对角线 a[i]^2，它占据第 2i 和 2i + 1 两块
+  Integral carry = 0;
+  for (std::size_t i = 0; i < n && 2 * i < len; ++i) {
+    Integral cur = (Integral)a[i] * a[i] + out[2 * i] + carry;
+    out[2 * i] = (Limb)cur;
+    carry = cur >> LIMB_LEN;
+
+    if (2 * i + 1 < len) {
+      cur = carry + out[2 * i + 1];
+      out[2 * i + 1] = (Limb)cur;
+      carry = cur >> LIMB_LEN;
+    }
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 div_binary_search
-// 采用二分和乘法验证的除法
+// 辅助函数 sqr_karatsuba
+// Karatsuba 平方：x = A * B^k + B 时，x^2 = A^2 * B^{2k} + ((A + B)^2 - A^2 - B^2) * B^k + B^2，只需要三次平方
+// 平方本身能放进 Half 时整体交给 Half；否则两半和子平方只有约 n 块，只要不会被截断也放进 Half，栈上只剩结果是 M 位的
 
 template<std::size_t M>
-auto BigInteger<M>::div_binary_search(const BigInteger &a, const BigInteger &b) -> BigInteger {
-  BigInteger L(1), R(a);
-
-  while (L <= R) {
-    // 由于求 L + R 可能上溢出被取模，为此分类讨论
-    BigInteger mid = div_by_two(L) + div_by_two(R) + ((L.data.front() & 1) && (R.data.front() & 1));
+auto BigInteger<M>::sqr_karatsuba(const BigInteger &a) -> BigInteger {
+  std::size_t n = a.data.size();
 
-    // 二分
-    if (mid * b > a)
-      R = mid - 1;
-    else
-      L = mid + 1;
+  // 如果小于阈值，调用朴素平方
+  if (n < SQR_KARATSUBA_THRESHOLD) {
+    return sqr_base(a);
   }
 
-  BigInteger result(R.data);
-  result.fix();
-  return result;
+  if (HALF_BITS < M && 2 * n <= Half::LIMIT_NUMS)
+    return Half::sqr_karatsuba(a.template narrow<HALF_BITS>()).template widen<M>();
+
+  // (A + B)^2 最多 2 * (n - n / 2) + 2 块
+  if (2 * (n - n / 2) + 2 <= Half::LIMIT_NUMS)
+    return sqr_karatsuba_impl<HALF_BITS>(a);
+  return sqr_karatsuba_impl<M>(a);
 }
 
-/////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 pow
-// 调用幂次的实现
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::sqr_karatsuba_impl(const BigInteger &a) -> BigInteger {
+  typedef BigInteger<N> Part;
+  std::size_t n = a.data.size(), half = n / 2;
+
+  // 数组分裂
+  Part A = slice<N>(a, half, n - half), B = slice<N>(a, 0, half), S = A + B;
+
+  // 通过分治得到三个局部结果，规模足够大时并行计算
+  Part AA, BB, AB;
+  fork_join(n,
+            [&] { AA = Part::sqr_karatsuba(A); },
+            [&] { BB = Part::sqr_karatsuba(B); },
+            [&] { AB = Part::sqr_karatsuba(S); });
+
+  // 利用局部结果计算平方
+  AB -= AA, AB -= BB;
+  BigInteger result = BB.template widen<M>();
+  addmul_in_place(result, AB, 1, half, false);
+  addmul_in_place(result, AA, 1, half * 2, false);
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_full
+// 计算完整的乘积（结果不会被截断时使用），按较短一方的块数选择算法
+
+template<std::size_t M>
+auto BigInteger<M>::mul_full(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  std::size_t n = a.data.size(), m = b.data.size();
+  std::size_t s = n < m ? n : m;
+
+  // 乘积能放进 Half 时整体交给 Half，各算法栈上的临时对象随乘积的规模缩小，而不是都占 M 位
+  if (HALF_BITS < M && n + m <= Half::LIMIT_NUMS)
+    return Half::mul_full(a.template narrow<HALF_BITS>(), b.template narrow<HALF_BITS>()).template widen<M>();
+
+  if (s > MUL_NTT_THRESHOLD)
+    return mul_ntt(a, b);
+
+  // 两边长度相差一倍以上时，Toom-Cook 和 Karatsuba 的分段都以较长的一方为准，较短一方的高段全是 0，改为按较短一方分段
+  if (s >= MUL_KARATSUBA_THRESHOLD && (n >= 2 * m || m >= 2 * n)) {
+    const BigInteger &x = n > m ? a : b, &y = n > m ? b : a;
+    if (2 * s <= Half::LIMIT_NUMS)
+      return mul_unbalanced<HALF_BITS>(x, y);
+    return mul_unbalanced<M>(x, y);
+  }
+  if (s > MUL_TOOM4_THRESHOLD)
+    return mul_toom4(a, b);
+  if (s > MUL_TOOM3_THRESHOLD)
+    return mul_toom3(a, b);
+  return mul_karatsuba(a, b);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_unbalanced
+// 把 a 按 b 的块数 m 分段，每段与 b 做一次平衡的完整乘法，再错开 m 块累加到结果中
+// 每段的乘积不超过 2m 块，放在 BigInteger<N> 中，调用者保证不会被 2^N 截断
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::mul_unbalanced(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  typedef BigInteger<N> Part;
+  std::size_t n = a.data.size(), m = b.data.size();
+
+  Part y = slice<N>(b, 0, m);
+  BigInteger result;
+  for (std::size_t pos = 0; pos < n; pos += m)
+    addmul_in_place(result, Part::mul_full(slice<N>(a, pos, std::min(m, n - pos)), y), 1, pos, false);
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 关于 Toom-Cook 在模 2^M 下的插值
+// 把 a、b 按 k 块一段拆成多项式 a(x)、b(x)，x = (2^LIMB_LEN)^k，在若干点求值后相乘，再插值得到 c(x) = a(x) b(x) 的系数
+// 插值需要精确地除以 2 的幂和一些奇数，所有运算都在模 2^M 的环中进行：
+// 1. 除以奇数 d 就是乘以 d 在模 2^M 下的逆元（div_exact_limb），对真实值能被 d 整除的数结果是精确的
+// 2. 除以 2^s 只能右移，会丢掉最高的 s 位，即结果只在模 2^{M-s} 下正确
+//    但插值过程都是线性的，这些误差始终是 2^{M-s} 的倍数，而且只会出现在 c_1 ... c_{d-1} 中
+//    这些系数最终要乘以 x^i (i >= 1)，x 至少是 2^LIMB_LEN，误差乘上之后就是 2^M 的倍数，不影响结果
+// 负数的求值点先分别求出绝对值和符号再相乘，保证递归的乘法规模只有 k 块左右
+// 各段、求值点的乘积和插值的中间结果都不超过 2k + 2 块，能放进 Half 时整个求值和插值都在 Half 中进行：
+// 被右移的中间结果的真实值都是非负的，在 Half 中没有误差，得到的系数再扩展到 M 位合并
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_toom3
+// Toom-3：分成三段，在 0, 1, -1, 2, ∞ 五个点求值，只需要五次 k 块的乘法
+
+template<std::size_t M>
+auto BigInteger<M>::mul_toom3(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  std::size_t n = a.data.size(), m = b.data.size();
+  std::size_t k = ((n > m ? n : m) + 2) / 3;
+
+  // 两边都至少要有三段，否则退回 Karatsuba
+  if (n <= 2 * k || m <= 2 * k)
+    return mul_karatsuba(a, b);
+
+  if (2 * k + 2 <= Half::LIMIT_NUMS)
+    return mul_toom3_impl<HALF_BITS>(a, b, k);
+  return mul_toom3_impl<M>(a, b, k);
+}
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::mul_toom3_impl(const BigInteger &a, const BigInteger &b, std::size_t k) -> BigInteger {
+  typedef BigInteger<N> Part;
+  std::size_t n = a.data.size(), m = b.data.size();
+
+  Part a0 = slice<N>(a, 0, k), a1 = slice<N>(a, k, k), a2 = slice<N>(a, 2 * k, n - 2 * k);
+  Part b0 = slice<N>(b, 0, k), b1 = slice<N>(b, k, k), b2 = slice<N>(b, 2 * k, m - 2 * k);
+
+  // 求值
+  Part pa = a0 + a2, pb = b0 + b2, ta, tb;
+  bool negative = Part::sub_abs(pa, a1, ta) != Part::sub_abs(pb, b1, tb);
+  Part sa = pa + a1, sb = pb + b1, da = a0, db = b0;
+  Part::addmul_in_place(da, a1, 2, 0, false), Part::addmul_in_place(da, a2, 4, 0, false), da.fix();
+  Part::addmul_in_place(db, b1, 2, 0, false), Part::addmul_in_place(db, b2, 4, 0, false), db.fix();
+
+  // 五次乘法互相独立，规模足够大时并行计算
+  Part v0, v1, vm1, v2, vinf;
+  fork_join(n < m ? n : m,
+            [&] { v0 = Part::mul(a0, b0); },      // c(0)
+            [&] { v1 = Part::mul(sa, sb); },      // c(1)
+            [&] { vm1 = Part::mul(ta, tb); },     // c(-1)
+            [&] { v2 = Part::mul(da, db); },      // c(2)
+            [&] { vinf = Part::mul(a2, b2); });   // c(∞)
+  if (negative)
+    vm1 = Part() - vm1;
+
+  // 插值
+  Part c2 = v1 + vm1;                 // (c(1) + c(-1)) / 2 = c0 + c2 + c4
+  Part::shr_in_place(c2, 1);
+  c2 -= v0, c2 -= vinf;
+
+  Part c1 = v1 - vm1;                 // (c(1) - c(-1)) / 2 = c1 + c3
+  Part::shr_in_place(c1, 1);
+
+  Part c3 = v2 - v0;                  // (c(2) - c0 - 4c2 - 16c4) / 2 = c1 + 4c3
+  Part::addmul_in_place(c3, c2, 4, 0, true), Part::addmul_in_place(c3, vinf, 16, 0, true), c3.fix();
+  Part::shr_in_place(c3, 1);
+  c3 -= c1;
+  Part::div_exact_limb(c3, 3);
+  c1 -= c3;
+
+  // 合并
+  BigInteger result = v0.template widen<M>();
+  addmul_in_place(result, c1, 1, k, false);
+  addmul_in_place(result, c2, 1, 2 * k, false);
+  addmul_in_place(result, c3, 1, 3 * k, false);
+  addmul_in_place(result, vinf, 1, 4 * k, false);
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_toom4
+// Toom-4：分成四段，在 0, 1, -1, 2, -2, 1/2, ∞ 七个点求值，只需要七次 k 块的乘法
+// 其中 1/2 处实际计算的是 64 c(1/2) = (8 a(1/2)) (8 b(1/2))，避免出现分数
+
+template<std::size_t M>
+auto BigInteger<M>::mul_toom4(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  std::size_t n = a.data.size(), m = b.data.size();
+  std::size_t k = ((n > m ? n : m) + 3) / 4;
+
+  // 两边都至少要有四段，否则退回 Toom-3
+  if (n <= 3 * k || m <= 3 * k)
+    return mul_toom3(a, b);
+
+  if (2 * k + 2 <= Half::LIMIT_NUMS)
+    return mul_toom4_impl<HALF_BITS>(a, b, k);
+  return mul_toom4_impl<M>(a, b, k);
+}
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::mul_toom4_impl(const BigInteger &a, const BigInteger &b, std::size_t k) -> BigInteger {
+  typedef BigInteger<N> Part;
+  std::size_t n = a.data.size(), m = b.data.size();
+
+  Part a0 = slice<N>(a, 0, k), a1 = slice<N>(a, k, k), a2 = slice<N>(a, 2 * k, k), a3 = slice<N>(a, 3 * k, n - 3 * k);
+  Part b0 = slice<N>(b, 0, k), b1 = slice<N>(b, k, k), b2 = slice<N>(b, 2 * k, k), b3 = slice<N>(b, 3 * k, m - 3 * k);
+
+  // 求值：偶数次项与奇数次项分开计算，±1、±2 处共用，带系数的项原地累加
+  Part ea = a0 + a2, oa = a1 + a3, eb = b0 + b2, ob = b1 + b3, ta, tb;
+  Part ea2 = a0, oa2 = Part::shl(a1, 1), eb2 = b0, ob2 = Part::shl(b1, 1), ha = a3, hb = b3;
+  Part::addmul_in_place(ea2, a2, 4, 0, false), Part::addmul_in_place(oa2, a3, 8, 0, false), ea2.fix(), oa2.fix();
+  Part::addmul_in_place(eb2, b2, 4, 0, false), Part::addmul_in_place(ob2, b3, 8, 0, false), eb2.fix(), ob2.fix();
+  Part::addmul_in_place(ha, a2, 2, 0, false), Part::addmul_in_place(ha, a1, 4, 0, false);
+  Part::addmul_in_place(ha, a0, 8, 0, false), ha.fix();
+  Part::addmul_in_place(hb, b2, 2, 0, false), Part::addmul_in_place(hb, b1, 4, 0, false);
+  Part::addmul_in_place(hb, b0, 8, 0, false), hb.fix();
+
+  Part sa = ea + oa, sb = eb + ob, sa2 = ea2 + oa2, sb2 = eb2 + ob2, ta2, tb2;
+  bool negative1 = Part::sub_abs(ea, oa, ta) != Part::sub_abs(eb, ob, tb);
+  bool negative2 = Part::sub_abs(ea2, oa2, ta2) != Part::sub_abs(eb2, ob2, tb2);
+
+  // 七次乘法互相独立，规模足够大时并行计算
+  Part v0, v1, vm1, v2, vm2, vh, vinf;
+  fork_join(n < m ? n : m,
+            [&] { v0 = Part::mul(a0, b0); },      // c(0)
+            [&] { v1 = Part::mul(sa, sb); },      // c(1)
+            [&] { vm1 = Part::mul(ta, tb); },     // c(-1)
+            [&] { v2 = Part::mul(sa2, sb2); },    // c(2)
+            [&] { vm2 = Part::mul(ta2, tb2); },   // c(-2)
+            [&] { vh = Part::mul(ha, hb); },      // 64 c(1/2)
+            [&] { vinf = Part::mul(a3, b3); });   // c(∞)
+  if (negative1)
+    vm1 = Part() - vm1;
+  if (negative2)
+    vm2 = Part() - vm2;
+
+  // 插值：先求偶数次系数 c2、c4
+  Part e1 = v1 + vm1;                       // (c(1) + c(-1)) / 2 - c0 - c6 = c2 + c4
+  Part::shr_in_place(e1, 1);
+  e1 -= v0, e1 -= vinf;
+
+  Part c4 = v2 + vm2;                       // ((c(2) + c(-2)) / 2 - c0 - 64c6) / 4 = c2 + 4c4
+  Part::shr_in_place(c4, 1);
+  c4 -= v0, Part::addmul_in_place(c4, vinf, 64, 0, true), c4.fix();
+  Part::shr_in_place(c4, 2);
+  c4 -= e1;
+  Part::div_exact_limb(c4, 3);
+  Part c2 = e1 - c4;
+
+  // 再求奇数次系数 c1、c3、c5
+  Part o1 = v1 - vm1;                       // (c(1) - c(-1)) / 2 = c1 + c3 + c5
+  Part::shr_in_place(o1, 1);
+
+  Part p = v2 - vm2;                        // ((c(2) - c(-2)) / 4 - o1) / 3 = c3 + 5c5
+  Part::shr_in_place(p, 2);
+  p -= o1;
+  Part::div_exact_limb(p, 3);
+
+  Part u = vh - vinf;                       // (64 c(1/2) - 64c0 - 16c2 - 4c4 - c6) / 2 = 16c1 + 4c3 + c5
+  Part::addmul_in_place(u, v0, 64, 0, true), Part::addmul_in_place(u, c2, 16, 0, true);
+  Part::addmul_in_place(u, c4, 4, 0, true), u.fix();
+  Part::shr_in_place(u, 1);
+
+  Part c3 = Part::shl(o1, 4);               // (16 o1 - u) / 3 = 4c3 + 5c5
+  c3 -= u;
+  Part::div_exact_limb(c3, 3);
+  c3 -= p;                                  // ((4c3 + 5c5) - (c3 + 5c5)) / 3 = c3
+  Part::div_exact_limb(c3, 3);
+
+  Part c5 = p - c3;                         // (p - c3) / 5 = c5
+  Part::div_exact_limb(c5, 5);
+
+  Part c1 = o1 - c3;
+  c1 -= c5;
+
+  // 合并
+  BigInteger result = v0.template widen<M>();
+  addmul_in_place(result, c1, 1, k, false);
+  addmul_in_place(result, c2, 1, 2 * k, false);
+  addmul_in_place(result, c3, 1, 3 * k, false);
+  addmul_in_place(result, c4, 1, 4 * k, false);
+  addmul_in_place(result, c5, 1, 5 * k, false);
+  addmul_in_place(result, vinf, 1, 6 * k, false);
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_ntt
+// 把每块拆成若干个 32 位的系数，分别在三个素数下用 NTT 计算循环卷积，再用 Garner 算法逐项还原并进位
+// 全部是整数运算，结果是精确的；只需要低 LIMIT_NUMS 块，更高的系数直接丢弃
+
+template<std::size_t M>
+auto BigInteger<M>::mul_ntt(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  typedef std::uint32_t Word;
+  typedef std::uint64_t Wide;
+
+  // 拆成 32 位的系数，并去掉最高的 0
+  auto split = [](const BigInteger &x) {
+    std::vector<Word> words(x.data.size() * NTT_WORDS_PER_LIMB);
+    for (std::size_t i = 0; i < x.data.size(); ++i)
+      for (std::size_t j = 0; j < NTT_WORDS_PER_LIMB; ++j)
+        words[i * NTT_WORDS_PER_LIMB + j] = (Word)(x.data[i] >> (32 * j));
+    while (!words.empty() && words.back() == 0)
+      words.pop_back();
+    return words;
+  };
+
+  bool same = &a == &b;
+  std::vector<Word> x = split(a), y = same ? std::vector<Word>() : split(b);
+  const std::vector<Word> &z = same ? x : y;
+  if (x.empty() || z.empty())
+    return BigInteger();
+
+  std::size_t terms = x.size() + z.size() - 1, len = 1;
+  while (len < terms)
+    len <<= 1;
+  // 超出模数支持的变换长度时退回 Toom-Cook（对于实际使用的 M 不会发生）
+  if (len > ((std::size_t)1 << NTT_MAX_LOG))
+    return a.data.size() + b.data.size() > LIMIT_NUMS ? mul_short(a, b, LIMIT_NUMS) : mul_toom4(a, b);
+
+  // 三个素数下的卷积互相独立，规模足够大时并行计算
+  std::vector<Word> r0, r1, r2;
+  fork_join(a.data.size() < b.data.size() ? a.data.size() : b.data.size(),
+            [&] { r0 = ntt_convolve<NTT_MOD0>(x, z, len, same); },
+            [&] { r1 = ntt_convolve<NTT_MOD1>(x, z, len, same); },
+            [&] { r2 = ntt_convolve<NTT_MOD2>(x, z, len, same); });
+
+  // Garner：c = a0 + a1 * p0 + a2 * p0 * p1，其中 a0 < p0，a1 < p1，a2 < p2
+  const Word inv01 = pow_mod_word<NTT_MOD1>(NTT_MOD0 % NTT_MOD1, NTT_MOD1 - 2);
+  const Word inv02 = pow_mod_word<NTT_MOD2>(NTT_MOD0 % NTT_MOD2, NTT_MOD2 - 2);
+  const Word inv12 = pow_mod_word<NTT_MOD2>(NTT_MOD1 % NTT_MOD2, NTT_MOD2 - 2);
+
+  // 乘积最多 x.size() + z.size() 个系数，其中只保留低 LIMIT_NUMS 块
+  std::size_t words = terms + 1;
+  if (words > LIMIT_NUMS * NTT_WORDS_PER_LIMB)
+    words = LIMIT_NUMS * NTT_WORDS_PER_LIMB;
+
+  BigInteger result;
+  result.data.resize((words + NTT_WORDS_PER_LIMB - 1) / NTT_WORDS_PER_LIMB, 0);
+
+  // 进位用三个 32 位的数 carry0 + carry1 * 2^32 + carry2 * 2^64 表示，存在 64 位整数中避免溢出
+  Wide carry0 = 0, carry1 = 0, carry2 = 0;
+  for (std::size_t i = 0; i < words; ++i) {
+    if (i < terms) {
+      Wide a0 = r0[i];
+      Wide a1 = (r1[i] + NTT_MOD1 - a0 % NTT_MOD1) % NTT_MOD1 * inv01 % NTT_MOD1;
+      Wide a2 = (r2[i] + NTT_MOD2 - a0 % NTT_MOD2) % NTT_MOD2 * inv02 % NTT_MOD2;
+      a2 = (a2 + NTT_MOD2 - a1 % NTT_MOD2) % NTT_MOD2 * inv12 % NTT_MOD2;
+
+      // v = a1 + a2 * p1 < 2^55，c = a0 + v * p0 按 32 位拆开累加
+      Wide v = a1 + a2 * NTT_MOD1;
+      Wide t0 = (v & 0xffffffffu) * NTT_MOD0 + a0;
+      Wide t1 = (v >> 32) * NTT_MOD0 + (t0 >> 32);
+      carry0 += t0 & 0xffffffffu;
+      carry1 += t1 & 0xffffffffu;
+      carry2 += t1 >> 32;
+    }
+
+    result.data[i / NTT_WORDS_PER_LIMB] |= (Limb)(carry0 & 0xffffffffu) << (32 * (i % NTT_WORDS_PER_LIMB));
+
+    Wide t = (carry0 >> 32) + carry1;
+    carry0 = t & 0xffffffffu;
+    t = (t >> 32) + carry2;
+    carry1 = t & 0xffffffffu;
+    carry2 = t >> 32;
+  }
+
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 pow_mod_word
+
+template<std::size_t M>
+template<std::uint32_t P>
+auto BigInteger<M>::pow_mod_word(std::uint32_t a, std::uint64_t e) -> std::uint32_t {
+  std::uint64_t result = 1, base = a % P;
+  for (; e; e >>= 1) {
+    if (e & 1)
+      result = result * base % P;
+    base = base * base % P;
+  }
+  return (std::uint32_t)result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 ntt
+// 迭代实现的 Cooley-Tukey 变换，先做位逆序置换，再从长度 2 开始逐层合并
+// P 是编译期常量，取模会被编译器优化成乘法
+
+template<std::size_t M>
+template<std::uint32_t P>
+auto BigInteger<M>::ntt(std::vector<std::uint32_t> &a, bool invert) -> void {
+  std::size_t n = a.size();
+
+  for (std::size_t i = 1, j = 0; i < n; ++i) {
+    std::size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      std::swap(a[i], a[j]);
+  }
+
+  std::vector<std::uint32_t> w(n / 2 > 0 ? n / 2 : 1);
+  for (std::size_t len = 2; len <= n; len <<= 1) {
+    std::size_t half = len / 2;
+
+    // 当前层的单位根，逆变换使用它的逆元
+    std::uint32_t root = pow_mod_word<P>(NTT_ROOT, (P - 1) / len);
+    if (invert)
+      root = pow_mod_word<P>(root, P - 2);
+    w[0] = 1;
+    for (std::size_t k = 1; k < half; ++k)
+      w[k] = (std::uint32_t)((std::uint64_t)w[k - 1] * root % P);
+
+    for (std::size_t i = 0; i < n; i += len) {
+      for (std::size_t k = 0; k < half; ++k) {
+        std::uint32_t u = a[i + k];
+        std::uint32_t v = (std::uint32_t)((std::uint64_t)a[i + k + half] * w[k] % P);
+        // 三个模数都小于 2^30，u + v 不会溢出
+        a[i + k] = u + v >= P ? u + v - P : u + v;
+        a[i + k + half] = u >= v ? u - v : u + P - v;
+      }
+    }
+  }
+
+  if (invert) {
+    std::uint64_t n_inv = pow_mod_word<P>((std::uint32_t)(n % P), P - 2);
+    for (auto &x : a)
+      x = (std::uint32_t)(x * n_inv % P);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 ntt_convolve
+// x 与 y 补 0 到 len 后变换、逐点相乘、逆变换；same 为 true 时 x 与 y 相同，只做一次正变换
+
+template<std::size_t M>
+template<std::uint32_t P>
+auto BigInteger<M>::ntt_convolve(const std::vector<std::uint32_t> &x, const std::vector<std::uint32_t> &y,
+                                 std::size_t len, bool same) -> std::vector<std::uint32_t> {
+  std::vector<std::uint32_t> fx(len, 0), fy;
+  for (std::size_t i = 0; i < x.size(); ++i)
+    fx[i] = x[i] % P;
+  ntt<P>(fx, false);
+
+  if (same) {
+    for (auto &v : fx)
+      v = (std::uint32_t)((std::uint64_t)v * v % P);
+  } else {
+    fy.assign(len, 0);
+    for (std::size_t i = 0; i < y.size(); ++i)
+      fy[i] = y[i] % P;
+    ntt<P>(fy, false);
+    for (std::size_t i = 0; i < len; ++i)
+      fx[i] = (std::uint32_t)((std::uint64_t)fx[i] * fy[i] % P);
+  }
+
+  ntt<P>(fx, true);
+  return fx;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_short
+// 短乘法（Mulders）：只计算 a * b 的低 n 块
+// 取 k 约为 0.7n，把 a、b 分成低 k 块 a0、b0 和其余部分 a1、b1，则
+// a * b mod B^n = a0 * b0 + (a1 * b0 + a0 * b1 mod B^{n-k}) * B^k，其中 B = 2^LIMB_LEN
+// a0 * b0 用完整的 Karatsuba 计算，两个交叉项递归地只计算低 n - k 块，a1 * b1 完全不需要计算
+
+template<std::size_t M>
+auto BigInteger<M>::mul_short(const BigInteger &a, const BigInteger &b, std::size_t n) -> BigInteger {
+  std::size_t na = a.data.size(), nb = b.data.size();
+
+  // 乘积本身不超过 n 块，没有可以省略的部分
+  if (na + nb <= n)
+    return mul_full(a, b);
+
+  // 规模较小时，截断的朴素乘法只计算下三角部分
+  if (n <= MUL_SHORT_THRESHOLD || na < MUL_KARATSUBA_THRESHOLD || nb < MUL_KARATSUBA_THRESHOLD) {
+    BigInteger result;
+    result.data.resize(n, 0);
+    mul_base_impl(a.data.data(), na, b.data.data(), nb, result.data.data(), n);
+    result.fix();
+    return result;
+  }
+
+  // 只有两边的低 n 块会影响结果，n 不超过 Half 的块数时整体交给 Half
+  if (HALF_BITS < M && n <= Half::LIMIT_NUMS)
+    return Half::mul_short(a.template narrow<HALF_BITS>(), b.template narrow<HALF_BITS>(), n).template widen<M>();
+
+  // 交叉项只需要低 n - k 块，不到 Half 的块数，直接放进 Half 中计算
+  std::size_t k = n * 7 / 10;
+  BigInteger A0 = slice(a, 0, k), B0 = slice(b, 0, k);
+  Half A1 = slice<HALF_BITS>(a, k, n - k), B1 = slice<HALF_BITS>(b, k, n - k);
+
+  // 两个交叉项和低位的完整乘积互相独立，规模足够大时并行计算
+  Half cross, cross2;
+  BigInteger result;
+  fork_join(na < nb ? na : nb,
+            [&] { cross = Half::mul_short(A1, B0.template narrow<HALF_BITS>(), n - k); },
+            [&] { cross2 = Half::mul_short(A0.template narrow<HALF_BITS>(), B1, n - k); },
+            [&] { result = mul_full(A0, B0); });
+  cross += cross2;
+  Half::low_blocks(cross, n - k);
+
+  addmul_in_place(result, cross, 1, k, false);
+  result.fix();
+  low_blocks(result, n);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 sqr_short
+// 短平方：a^2 mod B^n = a0^2 + (2 * a1 * a0 mod B^{n-k}) * B^k，交叉项用短乘法计算
+
+template<std::size_t M>
+auto BigInteger<M>::sqr_short(const BigInteger &a, std::size_t n) -> BigInteger {
+  std::size_t na = a.data.size();
+
+  // 平方本身不超过 n 块，没有可以省略的部分
+  if (2 * na <= n)
+    return sqr_karatsuba(a);
+
+  // 规模较小时，截断的朴素平方只计算下三角部分
+  if (n <= MUL_SHORT_THRESHOLD) {
+    BigInteger result;
+    result.data.resize(n, 0);
+    if (na <= SQR_BASE_THRESHOLD)
+      mul_base_impl(a.data.data(), na, a.data.data(), na, result.data.data(), n);
+    else
+      sqr_base_impl(a.data.data(), na, result.data.data(), n);
+    result.fix();
+    return result;
+  }
+
+  // 只有低 n 块会影响结果，n 不超过 Half 的块数时整体交给 Half
+  if (HALF_BITS < M && n <= Half::LIMIT_NUMS)
+    return Half::sqr_short(a.template narrow<HALF_BITS>(), n).template widen<M>();
+
+  // 与 mul_short 相同，交叉项放进 Half 中计算
+  std::size_t k = n * 7 / 10;
+  BigInteger A0 = slice(a, 0, k);
+  Half A1 = slice<HALF_BITS>(a, k, n - k);
+
+  // 交叉项和低位的平方互相独立，规模足够大时并行计算
+  Half cross;
+  BigInteger result;
+  fork_join(na,
+            [&] { cross = Half::mul_short(A1, A0.template narrow<HALF_BITS>(), n - k); },
+            [&] { result = sqr_karatsuba(A0); });
+  cross <<= 1;
+  Half::low_blocks(cross, n - k);
+
+  addmul_in_place(result, cross, 1, k, false);
+  result.fix();
+  low_blocks(result, n);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div
+// 调用除法的实现，并排除平凡情况
+
+template<std::size_t M>
+auto BigInteger<M>::div(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  // 对于比较平凡的情况进行特判
+  if (b.data.empty())
+    throw std::logic_error("division by zero");
+
+  if (a.data.empty() || a < b)
+    return BigInteger(0);
+
+  // 商和余数在 Knuth 算法 D 中是一起得到的，这里只取商
+  return divmod(a, b).first;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 带余除法 divmod
+// 根据除数的块数选择短除法或 Knuth 算法 D
+
+template<std::size_t M>
+auto BigInteger<M>::divmod(const BigInteger &a, const BigInteger &b) -> std::pair<BigInteger, BigInteger> {
+  if (b.data.empty())
+    throw std::logic_error("division by zero");
+
+  if (a < b)
+    return {BigInteger(0), a};
+
+  // 除数只有一块时，直接逐块做短除法
+  if (LIMIT_NUMS == 1 || b.data.size() == 1)
+    return div_single_limb(a, b.data.front());
+
+  return div_knuth(a, b);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_base
+// 转换乘减法的除法，已被 Knuth 算法 D 取代，保留作为对照
+
+template<std::size_t M>
+auto BigInteger<M>::div_base(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  BigInteger mod = a, div;
+  div.data.resize(a.data.size(), 0);
+
+  for (std::size_t i = a.data.size(); i > 0; --i) {
+    Limb res = 0;
+
+    // 枚举 2^k * b 是否能被减去，能减去就减去
+    for (std::size_t j = LIMB_LEN; j > 0; --j) {
+      BigInteger tmp(shl_inside_block(shl_block(b, i - 1), j - 1));
+
+      if (mod >= tmp) {
+        mod -= tmp;
+        res |= ((Limb)1 << (j - 1));
+      }
+    }
+
+    div.data[i - 1] = res;
+  }
+
+  div.fix();
+  return div;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_binary_search
+// 采用二分和乘法验证的除法，需要 O(M) 次乘法，已被 Knuth 算法 D 取代，保留作为对照
+
+template<std::size_t M>
+auto BigInteger<M>::div_binary_search(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  BigInteger L(1), R(a);
+
+  while (L <= R) {
+    // 由于求 L + R 可能上溢出被取模，为此分类讨论
+    BigInteger mid = div_by_two(L) + div_by_two(R) + (!R.data.empty() && (L.data.front() & 1) && (R.data.front() & 1));
+
+    // 二分
+    if (mid * b > a)
+      R = mid - 1;
+    else
+      L = mid + 1;
+  }
+
+  BigInteger result(R.data);
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_single_limb
+// 除数只有一块时的短除法，从高到低逐块求商，余数始终小于一块
+
+template<std::size_t M>
+auto BigInteger<M>::div_single_limb(const BigInteger &a, Limb b) -> std::pair<BigInteger, BigInteger> {
+  BigInteger quot, rem;
+  quot.data.resize(a.data.size(), 0);
+
+  Integral r = 0;
+  for (std::size_t i = a.data.size(); i > 0; --i) {
+    Integral cur = (r << LIMB_LEN) | a.data[i - 1];
+    quot.data[i - 1] = (Limb)(cur / b);
+    r = cur % b;
+  }
+
+  rem.data.push_back((Limb)r);
+  quot.fix(), rem.fix();
+  return {std::move(quot), std::move(rem)};
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_knuth
+// Knuth 算法 D（TAOCP 4.3.1），一次得到商和余数，要求除数至少两块且 a >= b
+
+template<std::size_t M>
+auto BigInteger<M>::div_knuth(const BigInteger &a, const BigInteger &b) -> std::pair<BigInteger, BigInteger> {
+  std::size_t n = b.data.size(), len = a.data.size();
+  Limb u[LIMIT_NUMS + 1], v[LIMIT_NUMS];
+
+  // D1. 规格化：整体左移使除数最高块的最高位为 1，这样试商最多只会偏大 2
+  std::size_t shift = 0;
+  for (Limb top = b.data.back(); (top >> (LIMB_LEN - 1)) == 0; top <<= 1)
+    ++shift;
+
+  for (std::size_t i = n; i > 0; --i)
+    v[i - 1] = (b.data[i - 1] << shift) | (shift && i > 1 ? b.data[i - 2] >> (LIMB_LEN - shift) : 0);
+  u[len] = shift ? a.data[len - 1] >> (LIMB_LEN - shift) : 0;
+  for (std::size_t i = len; i > 0; --i)
+    u[i - 1] = (a.data[i - 1] << shift) | (shift && i > 1 ? a.data[i - 2] >> (LIMB_LEN - shift) : 0);
+
+  BigInteger quot;
+  quot.data.resize(len - n + 1, 0);
+
+  for (std::size_t j = len - n + 1; j > 0; --j) {
+    std::size_t k = j - 1;
+
+    // D3. 用被除数最高的两块除以除数的最高块得到试商，再用次高块修正
+    Integral num = ((Integral)u[k + n] << LIMB_LEN) | u[k + n - 1];
+    Integral qhat = num / v[n - 1], rhat = num % v[n - 1];
+    while (qhat >= LIMB_BASE || qhat * v[n - 2] > ((rhat << LIMB_LEN) | u[k + n - 2])) {
+      --qhat, rhat += v[n - 1];
+      if (rhat >= LIMB_BASE)
+        break;
+    }
+
+    // D4. 乘减：u[k..k+n] -= qhat * v
+    Limb carry = 0, borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      Integral prod = qhat * v[i] + carry;
+      carry = (Limb)(prod >> LIMB_LEN);
+
+      Integral cur = (Integral)u[i + k] - (Limb)prod - borrow;
+      u[i + k] = (Limb)cur;
+      borrow = (Limb)(cur >> LIMB_LEN) & 1;
+    }
+    Integral top = (Integral)u[k + n] - carry - borrow;
+    u[k + n] = (Limb)top;
+
+    // D5 & D6. 结果为负说明试商偏大 1，加回一次除数
+    if ((top >> LIMB_LEN) != 0) {
+      --qhat;
+      carry = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        Integral cur = (Integral)u[i + k] + v[i] + carry;
+        u[i + k] = (Limb)cur;
+        carry = (Limb)(cur >> LIMB_LEN);
+      }
+      u[k + n] += carry;
+    }
+
+    quot.data[k] = (Limb)qhat;
+  }
+
+  // D8. 余数为 u 的低 n 块，需要右移回去
+  BigInteger rem;
+  rem.data.resize(n, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    rem.data[i] = (u[i] >> shift) | (shift ? u[i + 1] << (LIMB_LEN - shift) : 0);
+
+  quot.fix(), rem.fix();
+  return {std::move(quot), std::move(rem)};
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 pow
+// 调用幂次的实现
 
 template<std::size_t M>
 auto BigInteger<M>::pow(const BigInteger &a, const BigInteger &b) -> BigInteger {
@@ -644,13 +1798,18 @@ auto BigInteger<M>::pow_base(const BigInteger &a, const BigInteger &b) -> BigInt
     return BigInteger(1);
 
   BigInteger result(1), A(a);
+  std::size_t n = b.data.size();
 
   // 快速幂主体
-  for (auto it = b.data.begin(); it != b.data.end(); ++it) {
-    for (std::size_t i = 0; i < UNSIGNED_LEN; ++i) {
-      if ((*it >> i) & 1)
-        result = result * A;
-      A = A * A;
+  for (std::size_t k = 0; k < n; ++k) {
+    Limb bits = b.data[k];
+    for (std::size_t i = 0; i < LIMB_LEN; ++i, bits >>= 1) {
+      if (bits & 1)
+        result *= A;
+      // 最高块剩下的位全为 0 时，后面的平方都不会再被用到
+      if (k + 1 == n && (bits >> 1) == 0)
+        break;
+      A = sqr(A);
     }
   }
 
@@ -673,7 +1832,7 @@ auto BigInteger<M>::pow_packing(const BigInteger &a, const BigInteger &b) -> Big
   for (std::size_t i = 2; i < POW_PACKING_WINDOW_STORAGE_SIZE; ++i)
     g[i] = g[i - 1] * g[1];
 
-  BigInteger result(1), exp(shl(BigInteger(1), POW_PACKING_WINDOW_LENGTH));
+  BigInteger result(1);
 
   // 分块进行操作
   auto it = b.data.end();
@@ -681,12 +1840,14 @@ auto BigInteger<M>::pow_packing(const BigInteger &a, const BigInteger &b) -> Big
     --it;
 
     // 每一轮操作后结果为 result ^ {2 ^ length} * 这段区间的值，与位的权值对应
-    result = pow_base(result, exp) * g[*it >> (POW_PACKING_WINDOW_LENGTH * 3) & POW_PACKING_WINDOW_MASK];
-    result = pow_base(result, exp) * g[*it >> (POW_PACKING_WINDOW_LENGTH * 2) & POW_PACKING_WINDOW_MASK];
-    result = pow_base(result, exp) * g[*it >> (POW_PACKING_WINDOW_LENGTH * 1) & POW_PACKING_WINDOW_MASK];
-    result = pow_base(result, exp) * g[*it >> (POW_PACKING_WINDOW_LENGTH * 0) & POW_PACKING_WINDOW_MASK];
+    for (std::size_t k = LIMB_LEN / POW_PACKING_WINDOW_LENGTH; k > 0; --k) {
+      for (std::size_t i = 0; i < POW_PACKING_WINDOW_LENGTH; ++i)
+        result = sqr(result);
+      result *= g[*it >> (POW_PACKING_WINDOW_LENGTH * (k - 1)) & POW_PACKING_WINDOW_MASK];
+    }
   } while (it != b.data.begin());
 
+  delete[] g;
   result.fix();
   return result;
 }
@@ -697,57 +1858,71 @@ auto BigInteger<M>::pow_packing(const BigInteger &a, const BigInteger &b) -> Big
 
 template<std::size_t M>
 auto BigInteger<M>::pow_sliding_window(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  return pow_sliding_window_impl(a, b, BigInteger(1),
+      [](const BigInteger &x, const BigInteger &y) { return x * y; },
+      [](const BigInteger &x) { return sqr(x); });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 pow_sliding_window_impl
+// 滑动窗口的通用实现，只依赖乘法、平方和单位元，可以复用于其它模数下的幂次（例如 Montgomery 形式）
+
+template<std::size_t M>
+template<class Mul, class Sqr>
+auto BigInteger<M>::pow_sliding_window_impl(const BigInteger &a, const BigInteger &b, const BigInteger &one, Mul mul, Sqr sqr) -> BigInteger {
   if (b.data.empty())
-    return BigInteger(1);
+    return one;
 
   auto g = new BigInteger[POW_SLIDING_WINDOW_STORAGE_SIZE];
 
   // 预处理奇数
-  g[0] = BigInteger(1), g[1] = a, g[2] = a * a;
+  g[0] = one, g[1] = a, g[2] = sqr(a);
   for (std::size_t i = 3; i < POW_SLIDING_WINDOW_STORAGE_SIZE; i += 2)
-    g[i] = g[i - 2] * g[2];
+    g[i] = mul(g[i - 2], g[2]);
 
-  BigInteger result(1);
+  BigInteger result(one);
   auto pos = std::make_pair(b.data.end(), (std::int64_t)-1);
 
   do {
     // 解决下溢出问题
     if (pos.second < 0) {
-      pos.second += UNSIGNED_LEN;
+      pos.second += LIMB_LEN;
       --pos.first;
     }
 
     // 如果是 0，直接平方
     if ((((*pos.first) >> pos.second) & 1) == 0) {
-      result = result * result, --pos.second;
+      result = sqr(result), --pos.second;
     } else {
-      std::int64_t index = pos.second - POW_SLIDING_WINDOW_STORAGE_SIZE, mask = -1;
+      std::int64_t index = pos.second - (std::int64_t)POW_SLIDING_WINDOW_STORAGE_SIZE, mask = -1;
       auto nxt = pos.first;
-      --nxt;
+      if (nxt != b.data.begin()) --nxt;
 
-      for (std::int64_t i = pos.second - POW_SLIDING_WINDOW_LENGTH + 1; i <= pos.second; ++i) {
+      for (std::int64_t i = pos.second - (std::int64_t)POW_SLIDING_WINDOW_LENGTH + 1; i <= pos.second; ++i) {
         if (i < 0) {
           if (pos.first == b.data.begin())
             continue;
 
           // 如果 1 在前一个数中，记录位置并计算区间对应的值
-          if ((*nxt >> (UNSIGNED_LEN + i)) & 1) {
+          if ((*nxt >> (LIMB_LEN + i)) & 1) {
             index = i;
-            mask = (((*pos.first) & ((1LL << (pos.second + 1)) - 1)) << (-i)) | ((*nxt) >> (UNSIGNED_LEN + i));
+            mask = (std::int64_t)((((*pos.first) & (((Integral)1 << (pos.second + 1)) - 1)) << (-i)) | ((*nxt) >> (LIMB_LEN + i)));
             break;
           }
         } else {
           // 如果 1 在当前数中，记录位置并记录区间对应的值
           if (((*pos.first) >> i) & 1) {
             index = i;
-            mask = (*pos.first >> index) & ((1LL << (pos.second - index + 1)) - 1);
+            mask = (std::int64_t)((*pos.first >> index) & (((Integral)1 << (pos.second - index + 1)) - 1));
             break;
           }
         }
       }
 
-      // 计算这轮的结果并更新位置
-      result = pow_base(result, shl_inside_block(BigInteger(1), pos.second - index + 1)) * g[mask];
+      // 计算这轮的结果并更新位置：先平方窗口长度次，再乘上窗口对应的奇数次幂
+      for (std::int64_t i = index; i <= pos.second; ++i)
+        result = sqr(result);
+      result = mul(result, g[mask]);
       pos.second = index - 1;
     }
   } while (pos.first != b.data.begin() || pos.second >= 0);
@@ -756,13 +1931,439 @@ auto BigInteger<M>::pow_sliding_window(const BigInteger &a, const BigInteger &b)
   return result;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// 宽度转换
+// 块的宽度与 M 无关，低位在前的存储可以直接拷贝，变窄时由 fix 截断最高块并去掉前导 0
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::widen() const -> BigInteger<N> {
+  static_assert(N >= M, "widen cannot convert to a narrower BigInteger");
+  BigInteger<N> result;
+  result.data.resize(data.size(), 0);
+  std::copy(data.begin(), data.end(), result.data.begin());
+  return result;
+}
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::narrow() const -> BigInteger<N> {
+  static_assert(N <= M, "narrow cannot convert to a wider BigInteger");
+  std::size_t size = data.size() < BigInteger<N>::LIMIT_NUMS ? data.size() : BigInteger<N>::LIMIT_NUMS;
+  BigInteger<N> result;
+  result.data.resize(size, 0);
+  std::copy(data.begin(), data.begin() + size, result.data.begin());
+  result.fix();
+  return result;
+}
+
+template<std::size_t M>
+auto BigInteger<M>::low_half() const -> BigInteger<M / 2> {
+  static_assert(M % 2 == 0, "low_half needs an even M");
+  return narrow<M / 2>();
+}
+
+template<std::size_t M>
+auto BigInteger<M>::high_half() const -> BigInteger<M / 2> {
+  static_assert(M % 2 == 0, "high_half needs an even M");
+  std::size_t offset = M / 2 / LIMB_LEN;
+  if ((M / 2) % LIMB_LEN != 0)
+    return (*this >> (M / 2)).template narrow<M / 2>();
+
+  // 一半恰好落在块的边界上，直接拷贝高位的块
+  BigInteger<M / 2> result;
+  if (data.size() <= offset)
+    return result;
+  result.data.resize(data.size() - offset, 0);
+  std::copy(data.begin() + offset, data.end(), result.data.begin());
+  return result;
+}
+
+template<std::size_t M>
+auto BigInteger<M>::mul_wide(const BigInteger &a, const BigInteger &b) -> BigInteger<2 * M> {
+  // 两个数在 2M 位下的块数之和不超过 BigInteger<2M>::LIMIT_NUMS，乘法不会走截断的分支
+  if (&a == &b)
+    return BigInteger<2 * M>::sqr(a.template widen<2 * M>());
+  return a.template widen<2 * M>() * b.template widen<2 * M>();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 多重幂 multi_pow
+
+template<std::size_t M>
+auto BigInteger<M>::multi_pow(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps) -> BigInteger {
+  return multi_pow_impl(bases, exps, BigInteger(1),
+      [](const BigInteger &x, const BigInteger &y) { return x * y; },
+      [](const BigInteger &x) { return sqr(x); });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 multi_pow_impl
+// 两种方法的平方次数都约为指数的位数，只需比较乘法次数：
+// Straus 每项预处理 2^(w-1) 个奇数次幂，之后平均每 w + 1 位乘一次
+// Pippenger 每个长度为 c 的窗口把每项乘进一个桶，再用约 2^(c+1) 次乘法合并所有桶，项数很多时更省
+
+template<std::size_t M>
+template<class Mul, class Sqr>
+auto BigInteger<M>::multi_pow_impl(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr) -> BigInteger {
+  if (bases.size() != exps.size())
+    throw std::logic_error("multi_pow needs as many exponents as bases");
+
+  std::size_t n = bases.size(), bits = 0;
+  for (const auto &e : exps)
+    bits = e.bit_length() > bits ? e.bit_length() : bits;
+  if (bits == 0)
+    return one;
+
+  std::size_t straus_window = 1, straus_cost = std::numeric_limits<std::size_t>::max();
+  for (std::size_t w = 1; w <= MULTI_POW_STRAUS_MAX_WINDOW_LENGTH; ++w) {
+    std::size_t cost = n * (((std::size_t)1 << (w - 1)) + bits / (w + 1));
+    if (cost < straus_cost)
+      straus_window = w, straus_cost = cost;
+  }
+
+  std::size_t pippenger_window = 1, pippenger_cost = std::numeric_limits<std::size_t>::max();
+  for (std::size_t c = 1; c <= MULTI_POW_PIPPENGER_MAX_WINDOW_LENGTH; ++c) {
+    std::size_t cost = (bits + c - 1) / c * (n + ((std::size_t)2 << c));
+    if (cost < pippenger_cost)
+      pippenger_window = c, pippenger_cost = cost;
+  }
+
+  if (pippenger_cost < straus_cost)
+    return multi_pow_pippenger(bases, exps, one, mul, sqr, pippenger_window);
+  return multi_pow_straus(bases, exps, one, mul, sqr, straus_window);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 multi_pow_straus
+// 与 pow_sliding_window_impl 相同地划分窗口：从高位的 1 开始取至多 window 位，并让窗口的最低位也是 1
+// 窗口记在最低位的位置上，从高到低扫描时每一位只平方一次，再乘上所有在这一位结束的窗口
+
+template<std::size_t M>
+template<class Mul, class Sqr>
+auto BigInteger<M>::multi_pow_straus(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr, std::size_t window) -> BigInteger {
+  std::size_t n = bases.size(), half = (std::size_t)1 << (window - 1), bits = 0;
+
+  // 预处理每项的奇数次幂 a^1, a^3, ..., a^{2^window - 1}
+  std::vector<BigInteger> table(n * half);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (exps[i].data.empty())
+      continue;
+    BigInteger *g = &table[i * half];
+    g[0] = bases[i];
+    if (half > 1) {
+      BigInteger a2 = sqr(bases[i]);
+      for (std::size_t j = 1; j < half; ++j)
+        g[j] = mul(g[j - 1], a2);
+    }
+  }
+
+  // 每项的窗口按位置从高到低排列：(窗口最低位的位置, 奇数次幂的下标)
+  std::vector<std::vector<std::pair<std::size_t, std::size_t>>> windows(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const BigInteger &e = exps[i];
+    std::size_t p = e.bit_length();
+    bits = p > bits ? p : bits;
+    while (p > 0) {
+      if (!e.test_bit(p - 1)) {
+        --p;
+        continue;
+      }
+      std::size_t q = p > window ? p - window : 0;
+      while (!e.test_bit(q))
+        ++q;
+      windows[i].emplace_back(q, e.bits_at(q, p - q) >> 1);
+      p = q;
+    }
+  }
+
+  std::vector<std::size_t> next(n, 0);
+  BigInteger result(one);
+  bool started = false;
+  for (std::size_t p = bits; p > 0; --p) {
+    if (started)
+      result = sqr(result);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (next[i] == windows[i].size() || windows[i][next[i]].first != p - 1)
+        continue;
+      const BigInteger &g = table[i * half + windows[i][next[i]].second];
+      result = started ? mul(result, g) : g;
+      started = true, ++next[i];
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 multi_pow_pippenger
+// 从高到低处理每个长度为 window 的窗口：先把结果平方 window 次，再乘上 prod_i a_i^{d_i}，d_i 为第 i 项在这个窗口的取值
+// 把 d_i 相同的底数乘进第 d_i 个桶 B_d，则 prod_d B_d^d = prod_d (prod_{j >= d} B_j)，从大到小累乘后缀积即可
+// 空桶和尚未开始的结果都不参与乘法
+
+template<std::size_t M>
+template<class Mul, class Sqr>
+auto BigInteger<M>::multi_pow_pippenger(const std::vector<BigInteger> &bases, const std::vector<BigInteger> &exps, const BigInteger &one, Mul mul, Sqr sqr, std::size_t window) -> BigInteger {
+  std::size_t n = bases.size(), count = ((std::size_t)1 << window) - 1, bits = 0;
+  for (const auto &e : exps)
+    bits = e.bit_length() > bits ? e.bit_length() : bits;
+
+  std::vector<BigInteger> buckets(count);
+  std::vector<bool> used(count);
+  BigInteger result(one);
+  bool started = false;
+
+  for (std::size_t k = (bits + window - 1) / window; k > 0; --k) {
+    if (started)
+      for (std::size_t i = 0; i < window; ++i)
+        result = sqr(result);
+
+    std::fill(used.begin(), used.end(), false);
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t d = exps[i].bits_at((k - 1) * window, window);
+      if (d == 0)
+        continue;
+      buckets[d - 1] = used[d - 1] ? mul(buckets[d - 1], bases[i]) : bases[i];
+      used[d - 1] = true;
+    }
+
+    BigInteger suffix, sum;
+    bool has_suffix = false, has_sum = false;
+    for (std::size_t d = count; d > 0; --d) {
+      if (used[d - 1]) {
+        suffix = has_suffix ? mul(suffix, buckets[d - 1]) : buckets[d - 1];
+        has_suffix = true;
+      }
+      if (has_suffix) {
+        sum = has_sum ? mul(sum, suffix) : suffix;
+        has_sum = true;
+      }
+    }
+
+    if (has_sum) {
+      result = started ? mul(result, sum) : sum;
+      started = true;
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 bits_at
+
+template<std::size_t M>
+auto BigInteger<M>::bits_at(std::size_t pos, std::size_t len) const -> std::size_t {
+  std::size_t index = pos / LIMB_LEN, offset = pos % LIMB_LEN;
+  if (index >= data.size())
+    return 0;
+  std::size_t value = (std::size_t)(data[index] >> offset);
+  if (offset + len > LIMB_LEN && index + 1 < data.size())
+    value |= (std::size_t)data[index + 1] << (LIMB_LEN - offset);
+  return value & (((std::size_t)1 << len) - 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 常数时间幂次 pow_ct
+// 固定窗口：指数的每 POW_CT_WINDOW_LENGTH 位都先平方同样的次数再乘上一个表项，表项通过扫描整张表取出
+// 所有运算都在 LIMIT_NUMS 块的定长数组上进行，指数一律按 LIMIT_NUMS * LIMB_LEN 位处理
+// 注意：BigInteger 本身会去掉前导 0，读入指数时的拷贝长度仍然会暴露指数所占的块数
+
+template<std::size_t M>
+auto BigInteger<M>::pow_ct(const BigInteger &a, const BigInteger &b) -> BigInteger {
+  const std::size_t n = LIMIT_NUMS;
+  std::vector<Limb> table(POW_CT_TABLE_SIZE * n, 0), result(n, 0), tmp(n), entry(n), exp(n, 0);
+
+  // 预处理 a^0, a^1, ..., a^{2^w - 1}
+  table[0] = 1;
+  std::copy(a.data.begin(), a.data.end(), table.begin() + n);
+  for (std::size_t i = 2; i < POW_CT_TABLE_SIZE; ++i)
+    ct_mul_low(&table[i * n], &table[(i - 1) * n], &table[n], n);
+
+  std::copy(b.data.begin(), b.data.end(), exp.begin());
+  result[0] = 1;
+
+  for (std::size_t k = n; k > 0; --k) {
+    for (std::size_t w = LIMB_LEN / POW_CT_WINDOW_LENGTH; w > 0; --w) {
+      for (std::size_t i = 0; i < POW_CT_WINDOW_LENGTH; ++i) {
+        ct_mul_low(tmp.data(), result.data(), result.data(), n);
+        result.swap(tmp);
+      }
+      ct_lookup(entry.data(), table.data(), POW_CT_TABLE_SIZE, n,
+                (std::size_t)(exp[k - 1] >> (POW_CT_WINDOW_LENGTH * (w - 1))) & POW_CT_WINDOW_MASK);
+      ct_mul_low(tmp.data(), result.data(), entry.data(), n);
+      result.swap(tmp);
+    }
+  }
+
+  BigInteger r;
+  r.data.resize(n, 0);
+  std::copy(result.begin(), result.end(), r.data.begin());
+  r.fix();
+  return r;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 常数时间辅助函数 ct_sub
+// 固定处理 n 块，借位只参与算术运算，out 可以与 a、b 相同
+
+template<std::size_t M>
+auto BigInteger<M>::ct_sub(Limb *out, const Limb *a, const Limb *b, std::size_t n) -> Limb {
+  Limb borrow = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    Integral cur = (Integral)a[i] - b[i] - borrow;
+    out[i] = (Limb)cur;
+    borrow = (Limb)(cur >> LIMB_LEN) & 1;
+  }
+  return borrow;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 常数时间辅助函数 ct_select、ct_lookup
+// 用全 0 或全 1 的掩码代替分支
+
+template<std::size_t M>
+auto BigInteger<M>::ct_select(Limb *out, const Limb *a, const Limb *b, std::size_t n, Limb flag) -> void {
+  Limb mask = (Limb)0 - flag;
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = (a[i] & mask) | (b[i] & ~mask);
+}
+
+template<std::size_t M>
+auto BigInteger<M>::ct_lookup(Limb *out, const Limb *table, std::size_t count, std::size_t n, std::size_t index) -> void {
+  std::fill(out, out + n, 0);
+  for (std::size_t k = 0; k < count; ++k) {
+    // k == index 时 diff - 1 在两倍宽度下为全 1，右移后得到全 1 的掩码，否则为 0
+    Limb diff = (Limb)(k ^ index);
+    Limb mask = (Limb)(((Integral)diff - 1) >> LIMB_LEN);
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] |= table[k * n + i] & mask;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 常数时间辅助函数 ct_mul_low
+// 截断的朴素乘法，不跳过为 0 的块，循环次数只与 n 有关
+
+template<std::size_t M>
+auto BigInteger<M>::ct_mul_low(Limb *out, const Limb *a, const Limb *b, std::size_t n) -> void {
+  std::fill(out, out + n, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    Limb carry = 0;
+    for (std::size_t j = 0; i + j < n; ++j) {
+      Integral cur = (Integral)a[i] * b[j] + out[i + j] + carry;
+      out[i + j] = (Limb)cur;
+      carry = (Limb)(cur >> LIMB_LEN);
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 linear_combination
+// 依次把每一项原地累加到结果上，每一项只遍历一遍 x，移位和乘以系数都在同一个循环中完成，不构造任何临时的大整数
+// 把 |coefficient| * 2^(shift % LIMB_LEN) 拆成若干块，每一块乘以 x 后按整块错位累加，系数较小时只需要一遍
+// 除了 ±x 直接调用原地加减法以外，中间结果不截断，最后统一调用一次 fix
+
+template<std::size_t M>
+auto BigInteger<M>::linear_combination(const LinearTerm *terms, std::size_t count) -> BigInteger {
+  BigInteger result;
+  for (std::size_t j = 0; j < count; ++j) {
+    const LinearTerm &t = terms[j];
+    std::uint64_t abs_c = t.coefficient < 0 ? 0 - (std::uint64_t)t.coefficient : (std::uint64_t)t.coefficient;
+    bool negative = t.coefficient < 0;
+
+    // 系数为 ±1 且不移位时直接加减，避免乘法
+    if (abs_c == 1 && t.shift == 0) {
+      if (negative)
+        sub_in_place(result, *t.x);
+      else if (j == 0)
+        result = *t.x;
+      else
+        add_in_place(result, *t.x);
+      continue;
+    }
+
+    // 32 位块时系数可能超过一块，第 k 块再左移 r 位后分成低位 low 和溢出到下一块的 high
+    std::size_t q = t.shift / LIMB_LEN, r = t.shift % LIMB_LEN;
+    for (std::size_t k = 0; abs_c != 0; ++k) {
+      Limb digit = (Limb)abs_c;
+      Limb low = (Limb)(digit << r), high = r == 0 ? 0 : (Limb)(digit >> (LIMB_LEN - r));
+      addmul_in_place(result, *t.x, low, q + k, negative);
+      addmul_in_place(result, *t.x, high, q + k + 1, negative);
+      abs_c = LIMB_LEN < 64 ? abs_c >> (LIMB_LEN % 64) : 0;
+    }
+  }
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 addmul_in_place
+// a += c * x * b^q 或 a -= c * x * b^q，其中 b = 2^LIMB_LEN
+// 不调用 fix：a 可能带有前导零，最高块也可能超出 M 位，由调用者统一处理；结果为负数时借位传播到第 LIMIT_NUMS 块
+// 乘法的合并也用它把较窄的局部结果直接累加到 M 位的结果中，不需要先扩展再移位的临时对象
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::addmul_in_place(BigInteger &a, const BigInteger<N> &x, Limb c, std::size_t q, bool subtract) -> void {
+  std::size_t n = x.data.size();
+  if (c == 0 || n == 0 || q >= LIMIT_NUMS)
+    return;
+
+  // 超出 LIMIT_NUMS 的部分直接丢弃
+  std::size_t m = LIMIT_NUMS - q < n ? LIMIT_NUMS - q : n;
+  if (a.data.size() < q + m)
+    a.data.resize(q + m, 0);
+
+  Limb *p = a.data.data() + q;
+  const Limb *s = x.data.data();
+  Limb carry = 0;
+  if (subtract) {
+    for (std::size_t i = 0; i < m; ++i) {
+      Integral product = (Integral)s[i] * c + carry;
+      Limb low = (Limb)product;
+      carry = (Limb)(product >> LIMB_LEN) + (p[i] < low);
+      p[i] -= low;
+    }
+  } else {
+    for (std::size_t i = 0; i < m; ++i) {
+      Integral product = (Integral)s[i] * c + p[i] + carry;
+      p[i] = (Limb)product;
+      carry = (Limb)(product >> LIMB_LEN);
+    }
+  }
+
+  // 传播最后的进位或借位，此后至多为 1
+  std::size_t i = q + m;
+  Limb *d = a.data.data();
+  for (; carry && i < a.data.size(); ++i) {
+    if (subtract) {
+      Limb old = d[i];
+      d[i] -= carry;
+      carry = old < carry;
+    } else {
+      d[i] += carry;
+      carry = d[i] < carry;
+    }
+  }
+  if (!carry || i >= LIMIT_NUMS)
+    return;
+
+  if (!subtract) {
+    a.data.push_back(carry);
+  } else {
+    // 结果为负数，补码的高位全是 1
+    a.data.push_back(0 - carry);
+    a.data.resize(LIMIT_NUMS, (Limb)LIMB_MASK);
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 equal
 // 判断大整数是否相等
 
 template<std::size_t M>
 auto BigInteger<M>::equal(const BigInteger &a, const BigInteger &b) -> bool {
-  return a.data == b.data;
+  // 去掉前导 0 之后，块数不同的两个数一定不相等
+  return a.data.size() == b.data.size() && LimbSimd::equal(a.data.data(), b.data.data(), a.data.size());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -775,17 +2376,8 @@ auto BigInteger<M>::less_than(const BigInteger &a, const BigInteger &b) -> bool
   if (a.data.size() != b.data.size())
     return a.data.size() < b.data.size();
 
-  auto it1 = a.data.end(), it2 = b.data.end();
-  do {
-    --it1, --it2;
-
-    // 找到第一个不同的位置，可以确定大小关系
-    if (*it1 != *it2)
-      return *it1 < *it2;
-  } while (it1 != a.data.begin() && it2 != b.data.begin());
-
-  // 相等，返回 false
-  return false;
+  // 否则从高位到低位找到第一个不同的块，可以确定大小关系；相等时返回 false
+  return LimbSimd::compare(a.data.data(), b.data.data(), a.data.size()) < 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -794,13 +2386,10 @@ auto BigInteger<M>::less_than(const BigInteger &a, const BigInteger &b) -> bool
 
 template<std::size_t M>
 inline auto BigInteger<M>::fix() -> void {
-  // 如果超出上限，则直接截断
-  while (!data.empty() && data.size() > LIMIT_NUMS)
-    data.pop_back();
-
-  // 对剩余的若干位进行截断操作
-  if (!data.empty()) {
-    data.back() &= UNSIGNED_BIT_MASKS[REM_BITS];
+  // 底层数组的容量就是上限，超出部分在各个辅助函数中已经被丢弃
+  // 只有占满上限时，才需要对最高块剩余的若干位进行截断操作
+  if (data.size() == LIMIT_NUMS) {
+    data.back() &= TOP_LIMB_MASK;
   }
 
   // 如果有前导 0，则直接删除前导 0
@@ -814,188 +2403,286 @@ inline auto BigInteger<M>::fix() -> void {
 
 template<std::size_t M>
 inline auto BigInteger<M>::shl(const BigInteger &x, std::size_t count) -> BigInteger {
-  return shl_inside_block(shl_block(x, count / UNSIGNED_LEN), count % UNSIGNED_LEN);
+  BigInteger result(x);
+  shl_in_place(result, count);
+  return result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 shl_block
-// 快速乘以 (2 ^ 32) ^ count
+// 快速乘以 (2 ^ LIMB_LEN) ^ count
 
 template<std::size_t M>
 inline auto BigInteger<M>::shl_block(const BigInteger &x, std::size_t count) -> BigInteger {
-  BigInteger result(x);
-  // 添加整块
-  for (std::size_t i = 0; i < count; ++i) {
-    result.data.push_front(0);
-  }
-  result.fix();
-  return result;
+  // 整体后移 count 块，低位补 0，超出上限的部分直接丢弃
+  if (count >= LIMIT_NUMS)
+    return BigInteger();
+  return shl(x, count * LIMB_LEN);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 shl_inside_block
-// 快速乘以 2 ^ k, k < 32
+// 快速乘以 2 ^ k, k < LIMB_LEN
 
 template<std::size_t M>
 auto BigInteger<M>::shl_inside_block(const BigInteger &x, std::size_t count) -> BigInteger {
-  if (count == 0)
-    return x;
+  assert(count < LIMB_LEN);
+  return shl(x, count);
+}
 
-  BigInteger result;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_by_two
+// 快速除以 2
 
-  assert(count < UNSIGNED_LEN);
+template<std::size_t M>
+auto BigInteger<M>::div_by_two(const BigInteger &x) -> BigInteger {
+  BigInteger result(x);
+  shr_in_place(result, 1);
+  return result;
+}
 
-  // 进行块内左移操作
-  result.data.push_back(0);
-  Integral mask = (1LL << (UNSIGNED_LEN - count)) - 1;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 low_blocks
+// 只保留最低的 n 块
 
-  for (auto i : x.data) {
-    result.data.back() |= (i & mask) << count;
-    result.data.push_back(i >> (UNSIGNED_LEN - count));
+template<std::size_t M>
+auto BigInteger<M>::low_blocks(BigInteger &x, std::size_t n) -> void {
+  if (x.data.size() > n) {
+    // 高处的块清零，由 fix 一并去掉
+    std::fill(x.data.begin() + n, x.data.end(), 0);
+    x.fix();
   }
+}
 
-  result.fix();
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 slice
+// 取出 [pos, pos + count) 这几块组成的大整数，超出 BigInteger<N> 的部分被截断
+
+template<std::size_t M>
+template<std::size_t N>
+auto BigInteger<M>::slice(const BigInteger &x, std::size_t pos, std::size_t count) -> BigInteger<N> {
+  BigInteger<N> result;
+  std::size_t n = x.data.size();
+  if (pos < n) {
+    std::size_t len = count < n - pos ? count : n - pos;
+    if (len > BigInteger<N>::LIMIT_NUMS)
+      len = BigInteger<N>::LIMIT_NUMS;
+    result.data.resize(len, 0);
+    std::copy(x.data.begin() + pos, x.data.begin() + (pos + len), result.data.begin());
+    result.fix();
+  }
   return result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 div_by_two
-// 快速除以 2
+// 辅助函数 sub_abs
+// 计算 |a - b|，并返回差是否为负
 
 template<std::size_t M>
-auto BigInteger<M>::div_by_two(const BigInteger &x) -> BigInteger {
-  if (x.data.empty())
-    return x;
-
-  BigInteger result;
-  result.data.push_back(x.data.front() >> 1);
-
-  // 进行分段右移操作
-  auto it = x.data.begin();
-  ++it;
+auto BigInteger<M>::sub_abs(const BigInteger &a, const BigInteger &b, BigInteger &result) -> bool {
+  if (less_than(a, b)) {
+    result = b - a;
+    return true;
+  }
+  result = a - b;
+  return false;
+}
 
-  for (; it != x.data.end(); ++it) {
-    result.data.back() |= (*it & 1) << 31;
-    result.data.push_back(*it >> 1);
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 div_exact_limb
+// 模 2^M 意义下除以奇数 d：从低到高逐块求商，每一块的商 q 满足 q * d 与当前块同余（Jebelean 精确除法）
+// 当 x 的真实值能被 d 整除时（可以是负数在环中的表示），结果就是精确的商
+
+template<std::size_t M>
+auto BigInteger<M>::div_exact_limb(BigInteger &x, Limb d) -> void {
+  assert(d & 1);
+
+  // 牛顿迭代求 d 在模 2^LIMB_LEN 下的逆元
+  Limb inv = d;
+  for (std::size_t bits = 3; bits < LIMB_LEN; bits *= 2)
+    inv *= (Limb)2 - d * inv;
+
+  // 负数的商会一直借位到最高块，所以需要处理全部 LIMIT_NUMS 块
+  x.data.resize(LIMIT_NUMS, 0);
+  Limb borrow = 0;
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    Limb cur = x.data[i], low = cur - borrow;
+    Limb q = low * inv;
+    x.data[i] = q;
+    borrow = (Limb)(((Integral)q * d) >> LIMB_LEN) + (cur < borrow);
   }
 
-  result.fix();
-  return result;
+  x.fix();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 decimal_to_binary
-// 将十进制数字（字符串类型）转成 2^32 进制（链表类型）
+// 将十进制数字（字符串类型）转成 2^LIMB_LEN 进制（数组类型）
 
 template<std::size_t M>
-auto BigInteger<M>::decimal_to_binary(const std::string &s, List<unsigned int> &list) -> void {
-  if (s.empty())
-    return;
-
-  auto *a = new Integral[s.length() + 1];
-  std::size_t len = s.length();
-  std::string res;
-
-  // 转换为数值数组
-  for (std::size_t i = 1; i <= len; ++i) {
-    if (!std::isdigit(s[i - 1]))
+auto BigInteger<M>::decimal_to_binary(const std::string &s, Storage &list) -> void {
+  for (char ch : s) {
+    if (!std::isdigit(ch))
       throw std::logic_error("invalid number");
-
-    a[i] = s[i - 1] - '0';
   }
+  if (s.empty())
+    return;
 
-  // 采取直接除以 2^32 取余的方式
-  Integral x = 0;
-  for (std::size_t i = 1; i <= len; ++i) {
-    Integral div = (x * 10 + a[i]) >> UNSIGNED_LEN;
-    x = (x * 10 + a[i]) & UNSIGNED_MASK;
-
-    res.push_back((char)div + '0');
-  }
+  // 10^M 是 2^M 的倍数，只有最低的 M 位十进制数字会影响结果
+  std::size_t start = s.length() > M ? s.length() - M : 0;
+  BigInteger result = decimal_to_binary_impl(s.data() + start, s.length() - start);
+  list.swap(result.data);
+}
 
-  // 消除前导 0
-  bool vis = false;
-  for (std::size_t i = 0; i < res.length(); ++i) {
-    if (res[i] != '0') {
-      res = res.substr(i);
-      vis = true;
-      break;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 decimal_to_binary_impl
+// 分治转换：s = hi * 10^k + lo，其中 k = DEC_CHUNK_DIGITS * 2^t 为小于 len 的最大值
+// 两半分别递归，最后做一次大整数乘法，复杂度与乘法同阶
+
+template<std::size_t M>
+auto BigInteger<M>::decimal_to_binary_impl(const char *s, std::size_t len) -> BigInteger {
+  // 位数较少时以 10^DEC_CHUNK_DIGITS 为基数，用秦九韶算法逐段累加
+  if (len <= DEC_CHUNK_DIGITS * DEC_CONVERSION_THRESHOLD) {
+    BigInteger result;
+    std::size_t head = len % DEC_CHUNK_DIGITS == 0 ? DEC_CHUNK_DIGITS : len % DEC_CHUNK_DIGITS;
+    for (std::size_t i = 0; i < len; ) {
+      std::size_t step = i == 0 ? head : DEC_CHUNK_DIGITS;
+      Limb chunk = 0, base = 1;
+      for (std::size_t j = 0; j < step; ++j, ++i) {
+        chunk = chunk * 10 + (Limb)(s[i] - '0');
+        base *= 10;
+      }
+      mul_add_limb(result, base, chunk);
     }
+    return result;
   }
-  if (!vis) res.clear();
 
-  // 把余数放入链表
-  list.push_back(x);
+  // 10^len 能放进 Half 时整体交给 Half，递归中的临时对象随位数缩小
+  if (HALF_BITS < M && len * 3322 < HALF_BITS * 1000)
+    return Half::decimal_to_binary_impl(s, len).template widen<M>();
 
-  delete[] a;
+  const std::vector<BigInteger> &powers = decimal_powers();
+  std::size_t t = 0;
+  while ((DEC_CHUNK_DIGITS << (t + 1)) < len)
+    ++t;
+  std::size_t k = DEC_CHUNK_DIGITS << t;
 
-  // 对一次除法得到的结果递归处理，直至被除数为 0
-  decimal_to_binary(res, list);
+  // 截断后 len <= M，而缓存中包含了所有 DEC_CHUNK_DIGITS * 2^t < M 的幂
+  assert(t < powers.size());
+  return decimal_to_binary_impl(s, len - k) * powers[t] + decimal_to_binary_impl(s + len - k, k);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // 辅助函数 binary_to_decimal
-// 将 2^32 进制（链表类型）转成十进制数字（字符串类型）
+// 将 2^LIMB_LEN 进制（数组类型）转成十进制数字（字符串类型）
 
 template<std::size_t M>
-auto BigInteger<M>::binary_to_decimal(const List<unsigned int> &list, std::string &s) -> void {
-  auto it = list.begin();
-  std::string base = "1";
-  std::string result;
+auto BigInteger<M>::binary_to_decimal(const Storage &list, std::string &s) -> void {
+  s.clear();
 
-  for (; it != list.end(); ++it) {
-    // 转化为二进制转十进制，可以避免写乘法，时间复杂度相同
-    for (std::size_t i = 0; i < UNSIGNED_LEN; ++i) {
-      if ((*it >> i) & 1)
-        result = decimal_add(result, base);
-      base = decimal_add(base, base);
-    }
+  // 针对 0 特殊处理
+  if (list.empty()) {
+    s = "0";
+    return;
   }
 
-  s.swap(result);
-  std::reverse(s.begin(), s.end());
+  BigInteger x;
+  x.data.reconstruct(list);
 
-  // 消除前导 0
-  bool vis = false;
-  for (std::size_t i = 0; i < s.length(); ++i) {
-    if (s[i] != '0') {
-      s = s.substr(i);
-      vis = true;
-      break;
-    }
-  }
-  // 针对 0 特殊处理
-  if (!vis) s = "0";
+  // 找到不超过 x 的最大的 10^(DEC_CHUNK_DIGITS * 2^t)，只使用没有被 2^M 截断的幂
+  // 这里用 log2(10) < 3.322 保守地判断 10^k < 2^M
+  const std::vector<BigInteger> &powers = decimal_powers();
+  std::size_t level = 0;
+  while (level < powers.size() && (DEC_CHUNK_DIGITS << level) * 3322 < M * 1000 && !(x < powers[level]))
+    ++level;
+
+  binary_to_decimal_impl(x, level, 0, s);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// 辅助函数 decimal_add
-// 实现十进制数字相加，用于辅助进制转换
+// 辅助函数 binary_to_decimal_impl
+// 分治转换：x = q * 10^k + r，其中 k = DEC_CHUNK_DIGITS * 2^(level - 1)
+// 商在前、余数在后依次追加到 s 末尾，余数需要补足 k 位前导 0；pad 为本段至少需要输出的位数
+
+template<std::size_t M>
+auto BigInteger<M>::binary_to_decimal_impl(const BigInteger &x, std::size_t level, std::size_t pad, std::string &s) -> void {
+  // 规模较小时反复除以 10^DEC_CHUNK_DIGITS，从低到高得到每一段
+  if (level == 0 || x.data.size() <= DEC_CONVERSION_THRESHOLD) {
+    std::string digits;
+    BigInteger cur = x;
+    while (!cur.data.empty()) {
+      auto qr = div_single_limb(cur, DEC_CHUNK_BASE);
+      Limb chunk = qr.second.data.empty() ? 0 : qr.second.data.front();
+      cur = qr.first;
+
+      // 最高的一段不输出前导 0
+      for (std::size_t j = 0; j < DEC_CHUNK_DIGITS && (chunk != 0 || !cur.data.empty()); ++j) {
+        digits.push_back((char)(chunk % 10) + '0');
+        chunk /= 10;
+      }
+    }
+    if (digits.length() < pad)
+      digits.append(pad - digits.length(), '0');
 
-template<std::size_t M>
-auto BigInteger<M>::decimal_add(std::string &a, std::string &b) -> std::string {
-  std::string result;
-  std::size_t len = std::max(a.length(), b.length());
+    s.append(digits.rbegin(), digits.rend());
+    return;
+  }
 
-  Integral rem = 0, lhs, rhs;
-  for (std::size_t i = 0; i < len; ++i) {
-    lhs = i < a.length() ? a[i] - '0' : 0;
-    rhs = i < b.length() ? b[i] - '0' : 0;
+  // x 能放进 Half 时整体交给 Half，只使用在 Half 中没有被截断的幂（与 binary_to_decimal 的判断相同）
+  if (HALF_BITS < M && x.data.size() <= Half::LIMIT_NUMS) {
+    while (level > 0 && (DEC_CHUNK_DIGITS << (level - 1)) * 3322 >= HALF_BITS * 1000)
+      --level;
+    Half::binary_to_decimal_impl(x.template narrow<HALF_BITS>(), level, pad, s);
+    return;
+  }
 
-    rem += lhs + rhs;
+  const BigInteger &power = decimal_powers()[level - 1];
+  std::size_t k = DEC_CHUNK_DIGITS << (level - 1);
 
-    result.push_back((char)(rem % 10) + '0');
-    rem /= 10;
+  if (x < power) {
+    binary_to_decimal_impl(x, level - 1, pad, s);
+    return;
   }
 
-  if (rem > 0) {
-    result.push_back((char)rem + '0');
-  }
+  auto qr = divmod(x, power);
+  binary_to_decimal_impl(qr.first, level - 1, pad > k ? pad - k : 0, s);
+  binary_to_decimal_impl(qr.second, level - 1, k, s);
+}
 
-  return result;
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 decimal_powers
+// 第 t 项为 10^(DEC_CHUNK_DIGITS * 2^t) mod 2^M，只保留 DEC_CHUNK_DIGITS * 2^t < M 的项（更大的幂模 2^M 为 0）
+// 每个 M 只在第一次使用时计算一次
+
+template<std::size_t M>
+auto BigInteger<M>::decimal_powers() -> const std::vector<BigInteger>& {
+  static const std::vector<BigInteger> powers = [] {
+    std::vector<BigInteger> result;
+    result.push_back(BigInteger((std::uint64_t)DEC_CHUNK_BASE));
+    while ((DEC_CHUNK_DIGITS << result.size()) < M)
+      result.push_back(result.back() * result.back());
+    return result;
+  }();
+  return powers;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul_add_limb
+// 原地计算 x = x * mul + add，超出 2^M 的部分被截断
 
-#endif //FDS_BIG_INTEGER_IMPL_
+template<std::size_t M>
+auto BigInteger<M>::mul_add_limb(BigInteger &x, Limb mul, Limb add) -> void {
+  Integral carry = add;
+  for (std::size_t i = 0; i < x.data.size(); ++i) {
+    Integral cur = (Integral)x.data[i] * mul + carry;
+    x.data[i] = (Limb)cur;
+    carry = cur >> LIMB_LEN;
+  }
+  if (carry != 0 && x.data.size() < LIMIT_NUMS)
+    x.data.push_back((Limb)carry);
+  x.fix();
+}
 
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_BIG_INTEGER_IMPL_
@@ -0,0 +1,84 @@
+#ifndef FDS_BIG_INTEGER_LITERAL_
+#define FDS_BIG_INTEGER_LITERAL_
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "big_integer.h"
+
+// 编译期大整数：模数、生成元和预先算好的表等常量可以在编译期构造和计算，结果直接放在只读数据段中，启动时不需要解析字符串
+// 与 BigInteger<M> 使用相同的块，但总是保存全部 LIMIT_NUMS 块（高位补零），所有运算都是 constexpr，只提供加减乘和移位
+// 需要运行期的运算时转换为 BigInteger<N>，只需要复制块
+// 例如 constexpr auto p = 0xfffffffffffffffffffffffffffffffeffffffffffffffff_big; BigInteger<256> x = p;
+template <std::size_t M>
+class BigIntegerLiteral {
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef typename Integer::Limb Limb;
+  typedef typename Integer::Integral Integral;
+
+ private: // 常量
+  constexpr static std::size_t LIMB_LEN = Integer::LIMB_LEN;
+  constexpr static std::size_t LIMIT_NUMS = Integer::LIMIT_NUMS;
+  constexpr static Limb TOP_LIMB_MASK = Integer::TOP_LIMB_MASK;
+
+ private: // 全部 LIMIT_NUMS 块，低位在前
+  Limb limbs[LIMIT_NUMS];
+
+ public: // 构造函数
+  constexpr BigIntegerLiteral();
+  constexpr explicit BigIntegerLiteral(std::uint64_t num);
+  // 0x 开头为十六进制，0b 开头为二进制，0 开头为八进制，否则为十进制，可以包含数字分隔符 '，超出 M 位的部分被截断
+  // 含有非法字符时 throw std::logic_error，在常量表达式中即为编译错误
+  constexpr explicit BigIntegerLiteral(const char *num);
+
+ public: // 模 2^M 意义下的运算
+  constexpr auto operator+(const BigIntegerLiteral &other) const -> BigIntegerLiteral;
+  constexpr auto operator-(const BigIntegerLiteral &other) const -> BigIntegerLiteral;
+  constexpr auto operator*(const BigIntegerLiteral &other) const -> BigIntegerLiteral;
+  constexpr auto operator<<(std::size_t bits) const -> BigIntegerLiteral;
+  constexpr auto operator>>(std::size_t bits) const -> BigIntegerLiteral;
+
+ public: // 比较
+  constexpr auto operator==(const BigIntegerLiteral &other) const -> bool;
+  constexpr auto operator!=(const BigIntegerLiteral &other) const -> bool;
+
+ public: // 宽度转换
+  template <std::size_t N>
+  constexpr auto widen() const -> BigIntegerLiteral<N>; // 要求 N >= M，数值不变
+  template <std::size_t N>
+  constexpr auto narrow() const -> BigIntegerLiteral<N>; // 要求 N <= M，结果为 this mod 2^N
+
+ public: // 转换为 BigInteger<N>，N < M 时截断
+  template <std::size_t N>
+  operator BigInteger<N>() const;
+
+ private: // 其他宽度的实例需要访问块
+  template <std::size_t N> friend class BigIntegerLiteral;
+
+ private: // 辅助函数
+  template <std::size_t N>
+  constexpr auto resize() const -> BigIntegerLiteral<N>; // 复制低位的块并截断到 N 位
+  constexpr auto truncate() -> void; // 截断最高块中超出 M 位的部分
+  constexpr auto mul_add(Limb mul, Limb add) -> void; // this = this * mul + add
+  constexpr auto set_bits(std::size_t pos, Limb value) -> void; // 从第 pos 位开始或上 value
+};
+
+// 字面量所需的位数：按进制和数字个数估计的上界，至少为 1
+constexpr auto big_integer_literal_bits(const char *num) -> std::size_t;
+
+// 把字面量的字符放进静态数组，并用静态成员在编译期求出它的值，保证 _big 字面量即使不在常量表达式中使用也不会在运行期解析
+template <char... Cs>
+struct BigIntegerLiteralChars {
+  constexpr static char chars[] = {Cs..., '\0'};
+  constexpr static std::size_t bits = big_integer_literal_bits(chars);
+  constexpr static BigIntegerLiteral<bits> value = BigIntegerLiteral<bits>(chars);
+};
+
+// 大整数字面量，宽度由字面量的长度决定，例如 0xffff_big 为 BigIntegerLiteral<16>
+template <char... Cs>
+constexpr auto operator"" _big() -> BigIntegerLiteral<BigIntegerLiteralChars<Cs...>::bits>;
+
+#endif //FDS_BIG_INTEGER_LITERAL_
+
+#include "big_integer_literal_impl.h"
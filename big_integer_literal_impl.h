@@ -0,0 +1,248 @@
+#ifndef FDS_BIG_INTEGER_LITERAL_IMPL_
+#define FDS_BIG_INTEGER_LITERAL_IMPL_
+
+#include "big_integer_literal.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// BigIntegerLiteral 构造函数实现
+
+template<std::size_t M>
+constexpr BigIntegerLiteral<M>::BigIntegerLiteral() : limbs() {}
+
+template<std::size_t M>
+constexpr BigIntegerLiteral<M>::BigIntegerLiteral(std::uint64_t num) : limbs() {
+  for (std::size_t i = 0; i < LIMIT_NUMS && num != 0; ++i) {
+    limbs[i] = (Limb)num;
+    num = LIMB_LEN < 64 ? num >> (LIMB_LEN % 64) : 0;
+  }
+  truncate();
+}
+
+// 2 的幂进制从最低位开始直接填写各个二进制位，十进制从最高位开始逐位乘 10 再加
+template<std::size_t M>
+constexpr BigIntegerLiteral<M>::BigIntegerLiteral(const char *num) : limbs() {
+  std::size_t base = 10, begin = 0, end = 0, digits = 0;
+  if (num[0] == '0' && (num[1] == 'x' || num[1] == 'X'))
+    base = 16, begin = 2;
+  else if (num[0] == '0' && (num[1] == 'b' || num[1] == 'B'))
+    base = 2, begin = 2;
+  else if (num[0] == '0' && num[1] != '\0')
+    base = 8, begin = 1;
+
+  for (end = begin; num[end] != '\0'; ++end) {
+    char c = num[end];
+    if (c == '\'')
+      continue;
+    std::size_t d = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : 16;
+    if (d >= base)
+      throw std::logic_error("invalid digit in big integer literal");
+    ++digits;
+  }
+  if (digits == 0)
+    throw std::logic_error("big integer literal has no digits");
+
+  if (base == 10) {
+    for (std::size_t i = begin; i < end; ++i)
+      if (num[i] != '\'')
+        mul_add(10, (Limb)(num[i] - '0'));
+  } else {
+    std::size_t width = base == 16 ? 4 : base == 8 ? 3 : 1, pos = 0;
+    for (std::size_t i = end; i > begin; --i) {
+      char c = num[i - 1];
+      if (c == '\'')
+        continue;
+      set_bits(pos, (Limb)(c <= '9' ? c - '0' : c <= 'F' ? c - 'A' + 10 : c - 'a' + 10));
+      pos += width;
+    }
+  }
+  truncate();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模 2^M 意义下的运算
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator+(const BigIntegerLiteral &other) const -> BigIntegerLiteral {
+  BigIntegerLiteral result;
+  Limb carry = 0;
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    Integral cur = (Integral)limbs[i] + other.limbs[i] + carry;
+    result.limbs[i] = (Limb)cur;
+    carry = (Limb)(cur >> LIMB_LEN);
+  }
+  result.truncate();
+  return result;
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator-(const BigIntegerLiteral &other) const -> BigIntegerLiteral {
+  BigIntegerLiteral result;
+  Limb borrow = 0;
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    Integral cur = (Integral)limbs[i] - other.limbs[i] - borrow;
+    result.limbs[i] = (Limb)cur;
+    borrow = (Limb)(cur >> LIMB_LEN) & 1;
+  }
+  result.truncate();
+  return result;
+}
+
+// 朴素乘法，只计算低 LIMIT_NUMS 块
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator*(const BigIntegerLiteral &other) const -> BigIntegerLiteral {
+  BigIntegerLiteral result;
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    if (limbs[i] == 0)
+      continue;
+    Limb carry = 0;
+    for (std::size_t j = 0; i + j < LIMIT_NUMS; ++j) {
+      Integral cur = (Integral)limbs[i] * other.limbs[j] + result.limbs[i + j] + carry;
+      result.limbs[i + j] = (Limb)cur;
+      carry = (Limb)(cur >> LIMB_LEN);
+    }
+  }
+  result.truncate();
+  return result;
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator<<(std::size_t bits) const -> BigIntegerLiteral {
+  BigIntegerLiteral result;
+  if (bits >= M)
+    return result;
+  std::size_t q = bits / LIMB_LEN, r = bits % LIMB_LEN;
+  for (std::size_t i = LIMIT_NUMS; i > q; --i) {
+    std::size_t j = i - 1 - q;
+    result.limbs[i - 1] = (Limb)(limbs[j] << r);
+    if (r != 0 && j > 0)
+      result.limbs[i - 1] |= (Limb)(limbs[j - 1] >> (LIMB_LEN - r));
+  }
+  result.truncate();
+  return result;
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator>>(std::size_t bits) const -> BigIntegerLiteral {
+  BigIntegerLiteral result;
+  if (bits >= M)
+    return result;
+  std::size_t q = bits / LIMB_LEN, r = bits % LIMB_LEN;
+  for (std::size_t i = 0; i + q < LIMIT_NUMS; ++i) {
+    result.limbs[i] = (Limb)(limbs[i + q] >> r);
+    if (r != 0 && i + q + 1 < LIMIT_NUMS)
+      result.limbs[i] |= (Limb)(limbs[i + q + 1] << (LIMB_LEN - r));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 比较
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator==(const BigIntegerLiteral &other) const -> bool {
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i)
+    if (limbs[i] != other.limbs[i])
+      return false;
+  return true;
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::operator!=(const BigIntegerLiteral &other) const -> bool { return !(*this == other); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 宽度转换
+
+template<std::size_t M>
+template<std::size_t N>
+constexpr auto BigIntegerLiteral<M>::widen() const -> BigIntegerLiteral<N> {
+  static_assert(N >= M, "widen<N>() requires N >= M");
+  return resize<N>();
+}
+
+template<std::size_t M>
+template<std::size_t N>
+constexpr auto BigIntegerLiteral<M>::narrow() const -> BigIntegerLiteral<N> {
+  static_assert(N <= M, "narrow<N>() requires N <= M");
+  return resize<N>();
+}
+
+template<std::size_t M>
+template<std::size_t N>
+BigIntegerLiteral<M>::operator BigInteger<N>() const {
+  constexpr std::size_t n = LIMIT_NUMS < BigInteger<N>::LIMIT_NUMS ? LIMIT_NUMS : BigInteger<N>::LIMIT_NUMS;
+  BigInteger<N> result;
+  result.data.resize(n, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    result.data[i] = limbs[i];
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 resize、truncate、mul_add、set_bits
+
+template<std::size_t M>
+template<std::size_t N>
+constexpr auto BigIntegerLiteral<M>::resize() const -> BigIntegerLiteral<N> {
+  BigIntegerLiteral<N> result;
+  for (std::size_t i = 0; i < LIMIT_NUMS && i < BigIntegerLiteral<N>::LIMIT_NUMS; ++i)
+    result.limbs[i] = limbs[i];
+  result.truncate();
+  return result;
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::truncate() -> void { limbs[LIMIT_NUMS - 1] &= TOP_LIMB_MASK; }
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::mul_add(Limb mul, Limb add) -> void {
+  Limb carry = add;
+  for (std::size_t i = 0; i < LIMIT_NUMS; ++i) {
+    Integral cur = (Integral)limbs[i] * mul + carry;
+    limbs[i] = (Limb)cur;
+    carry = (Limb)(cur >> LIMB_LEN);
+  }
+}
+
+template<std::size_t M>
+constexpr auto BigIntegerLiteral<M>::set_bits(std::size_t pos, Limb value) -> void {
+  std::size_t q = pos / LIMB_LEN, r = pos % LIMB_LEN;
+  if (q < LIMIT_NUMS)
+    limbs[q] |= (Limb)(value << r);
+  if (r != 0 && q + 1 < LIMIT_NUMS)
+    limbs[q + 1] |= (Limb)(value >> (LIMB_LEN - r));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 字面量
+// 十进制每一位不超过 log2(10) < 3.322 个二进制位
+
+constexpr auto big_integer_literal_bits(const char *num) -> std::size_t {
+  std::size_t width = 3322, begin = 0, digits = 0;
+  if (num[0] == '0' && (num[1] == 'x' || num[1] == 'X'))
+    width = 4000, begin = 2;
+  else if (num[0] == '0' && (num[1] == 'b' || num[1] == 'B'))
+    width = 1000, begin = 2;
+  else if (num[0] == '0' && num[1] != '\0')
+    width = 3000, begin = 1;
+
+  for (std::size_t i = begin; num[i] != '\0'; ++i)
+    digits += num[i] != '\'';
+  std::size_t bits = (digits * width + 999) / 1000;
+  return bits == 0 ? 1 : bits;
+}
+
+template <char... Cs>
+constexpr char BigIntegerLiteralChars<Cs...>::chars[];
+
+template <char... Cs>
+constexpr BigIntegerLiteral<BigIntegerLiteralChars<Cs...>::bits> BigIntegerLiteralChars<Cs...>::value;
+
+template <char... Cs>
+constexpr auto operator"" _big() -> BigIntegerLiteral<BigIntegerLiteralChars<Cs...>::bits> {
+  return BigIntegerLiteralChars<Cs...>::value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_BIG_INTEGER_LITERAL_IMPL_
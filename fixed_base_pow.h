@@ -0,0 +1,61 @@
+#ifndef FDS_FIXED_BASE_POW_
+#define FDS_FIXED_BASE_POW_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "big_integer.h"
+#include "montgomery.h"
+#include "thread_pool.h"
+
+// 固定底数的幂：对同一个底数 g 计算大量不同指数的 g^e（例如用同一个生成元生成密钥）
+// 与 pow_packing 一样按长度为 w 的窗口切分指数，但预处理的不是 g^d，而是每个窗口 k 的 g^(d * 2^(k * w))，d 取 [1, 2^w)
+// 于是 g^e 就是各个窗口对应表项的乘积，不需要任何平方，约 bits / w 次乘法
+// 各个窗口的乘积互不依赖，全局线程池有线程时按窗口分段并行计算，最后把各段的部分积相乘
+// 表中共有 ceil(max_bits / w) * (2^w - 1) 个数，每个数占 M / 8 字节，窗口越长求值越快，但表越大
+template <std::size_t M>
+class FixedBasePow {
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef MontgomeryContext<M> Context;
+  typedef typename Integer::Limb Limb;
+
+ private: // 常量
+  constexpr static std::size_t LIMB_LEN = Integer::LIMB_LEN;
+  constexpr static std::size_t DEFAULT_WINDOW_LENGTH = 4;
+  constexpr static std::size_t MAX_WINDOW_LENGTH = 8;
+  constexpr static std::size_t PARALLEL_GRAIN = 32; // 每个线程至少分到的乘法次数，再少就不值得并行
+
+ private: // 预处理得到的数据
+  std::shared_ptr<const Context> ctx; // 为空时在模 2^M 意义下计算，否则在模 ctx->modulus() 意义下计算
+  std::size_t window;                 // 窗口长度 w
+  std::size_t max_bits;               // 指数的最大位数
+  std::size_t windows;                // 窗口个数 ceil(max_bits / w)
+  Integer one;                        // 乘法单位元，模 n 时为 Montgomery 形式
+  std::vector<Integer> table;         // table[k * (2^w - 1) + d - 1] = g^(d * 2^(k * w))，模 n 时为 Montgomery 形式
+
+ public: // 构造函数，window 必须整除块长且不超过 MAX_WINDOW_LENGTH，否则 throw std::logic_error
+  explicit FixedBasePow(const Integer &g, std::size_t max_bits = M, std::size_t window = DEFAULT_WINDOW_LENGTH); // 模 2^M
+  FixedBasePow(const Integer &g, const Context &ctx, std::size_t max_bits = M, std::size_t window = DEFAULT_WINDOW_LENGTH); // 模 n
+
+ public: // 求值，指数超过 max_bits 位时 throw std::logic_error
+  auto pow(const Integer &e) const -> Integer;
+
+ public: // 获取参数
+  auto window_length() const -> std::size_t;
+  auto max_exponent_bits() const -> std::size_t;
+  auto table_size() const -> std::size_t; // 表中的数的个数
+
+ private: // 辅助函数
+  auto build(const Integer &g) -> void;
+  auto mul(const Integer &a, const Integer &b) const -> Integer;
+  auto digit(const Integer &e, std::size_t k) const -> std::size_t; // 指数第 k 个窗口的值
+  auto product(const std::vector<const Integer*> &factors, std::size_t lo, std::size_t hi) const -> Integer; // factors[lo, hi) 的乘积
+  static auto chunk_count(std::size_t work) -> std::size_t; // 共需 work 次乘法时分成的段数
+  static auto parallel_for(std::size_t n, std::size_t chunks, const std::function<void(std::size_t, std::size_t, std::size_t)> &f) -> void; // 把 [0, n) 分成 chunks 段交给全局线程池，f(段号, lo, hi)
+};
+
+#endif //FDS_FIXED_BASE_POW_
+
+#include "fixed_base_pow_impl.h"
@@ -0,0 +1,150 @@
+#ifndef FDS_FIXED_BASE_POW_IMPL_
+#define FDS_FIXED_BASE_POW_IMPL_
+
+#include "fixed_base_pow.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// FixedBasePow 构造函数实现
+
+template<std::size_t M>
+FixedBasePow<M>::FixedBasePow(const Integer &g, std::size_t max_bits, std::size_t window)
+    : window(window), max_bits(max_bits < M ? max_bits : M) {
+  build(g);
+}
+
+template<std::size_t M>
+FixedBasePow<M>::FixedBasePow(const Integer &g, const Context &ctx, std::size_t max_bits, std::size_t window)
+    : ctx(std::make_shared<Context>(ctx)), window(window), max_bits(max_bits < M ? max_bits : M) {
+  build(g);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 求值
+
+template<std::size_t M>
+auto FixedBasePow<M>::pow(const Integer &e) const -> Integer {
+  if (e.bit_length() > max_bits)
+    throw std::logic_error("exponent is too large for FixedBasePow");
+
+  std::vector<const Integer*> factors;
+  std::size_t per_window = ((std::size_t)1 << window) - 1;
+  for (std::size_t k = 0; k < windows; ++k) {
+    std::size_t d = digit(e, k);
+    if (d != 0)
+      factors.push_back(&table[k * per_window + d - 1]);
+  }
+
+  // 每段先求部分积，段数为 1 时就是串行计算
+  std::size_t chunks = chunk_count(factors.size());
+  std::vector<Integer> partial(chunks);
+  parallel_for(factors.size(), chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+    partial[c] = product(factors, lo, hi);
+  });
+
+  Integer result = partial[0];
+  for (std::size_t c = 1; c < chunks; ++c)
+    result = mul(result, partial[c]);
+
+  return ctx ? ctx->from_montgomery(result) : result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 获取参数
+
+template<std::size_t M>
+auto FixedBasePow<M>::window_length() const -> std::size_t { return window; }
+
+template<std::size_t M>
+auto FixedBasePow<M>::max_exponent_bits() const -> std::size_t { return max_bits; }
+
+template<std::size_t M>
+auto FixedBasePow<M>::table_size() const -> std::size_t { return table.size(); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 build
+// 先用平方依次求出各个窗口的底数 g^(2^(k * w))，再分别填写每个窗口的 2^w - 1 个表项，后者可以并行
+
+template<std::size_t M>
+auto FixedBasePow<M>::build(const Integer &g) -> void {
+  if (window == 0 || window > MAX_WINDOW_LENGTH || LIMB_LEN % window != 0)
+    throw std::logic_error("window length of FixedBasePow must divide the limb length and be at most 8");
+
+  windows = (max_bits + window - 1) / window;
+  std::size_t per_window = ((std::size_t)1 << window) - 1;
+  one = ctx ? ctx->to_montgomery(Integer(1)) : Integer(1);
+
+  std::vector<Integer> bases(windows);
+  Integer base = ctx ? ctx->to_montgomery(g) : g;
+  for (std::size_t k = 0; k < windows; ++k) {
+    bases[k] = base;
+    if (k + 1 < windows)
+      for (std::size_t i = 0; i < window; ++i)
+        base = mul(base, base);
+  }
+
+  table.assign(windows * per_window, Integer());
+  std::size_t chunks = chunk_count(windows * per_window);
+  if (chunks > windows)
+    chunks = windows;
+  parallel_for(windows, chunks, [&](std::size_t, std::size_t lo, std::size_t hi) {
+    for (std::size_t k = lo; k < hi; ++k) {
+      Integer *row = &table[k * per_window];
+      row[0] = bases[k];
+      for (std::size_t d = 1; d < per_window; ++d)
+        row[d] = mul(row[d - 1], bases[k]);
+    }
+  });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mul、digit、product
+
+template<std::size_t M>
+auto FixedBasePow<M>::mul(const Integer &a, const Integer &b) const -> Integer {
+  return ctx ? ctx->mont_mul(a, b) : a * b;
+}
+
+template<std::size_t M>
+auto FixedBasePow<M>::digit(const Integer &e, std::size_t k) const -> std::size_t {
+  std::size_t bit = k * window, pos = bit / LIMB_LEN;
+  if (pos >= e.data.size())
+    return 0;
+  return (std::size_t)(e.data[pos] >> (bit % LIMB_LEN)) & (((std::size_t)1 << window) - 1);
+}
+
+template<std::size_t M>
+auto FixedBasePow<M>::product(const std::vector<const Integer*> &factors, std::size_t lo, std::size_t hi) const -> Integer {
+  if (lo == hi)
+    return one;
+  Integer result = *factors[lo];
+  for (std::size_t i = lo + 1; i < hi; ++i)
+    result = mul(result, *factors[i]);
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 chunk_count、parallel_for
+// 段数不超过全局线程池的线程数加一，且每段至少有 PARALLEL_GRAIN 次乘法
+
+template<std::size_t M>
+auto FixedBasePow<M>::chunk_count(std::size_t work) -> std::size_t {
+  std::size_t chunks = ThreadPool::global().size() + 1, limit = work / PARALLEL_GRAIN;
+  if (chunks > limit)
+    chunks = limit;
+  return chunks == 0 ? 1 : chunks;
+}
+
+template<std::size_t M>
+auto FixedBasePow<M>::parallel_for(std::size_t n, std::size_t chunks,
+                                   const std::function<void(std::size_t, std::size_t, std::size_t)> &f) -> void {
+  std::vector<std::function<void()>> fns;
+  for (std::size_t c = 0; c < chunks; ++c) {
+    std::size_t lo = n * c / chunks, hi = n * (c + 1) / chunks;
+    fns.emplace_back([&f, c, lo, hi] { f(c, lo, hi); });
+  }
+  ThreadPool::global().invoke_all(fns);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_FIXED_BASE_POW_IMPL_
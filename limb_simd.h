@@ -0,0 +1,64 @@
+#ifndef FDS_LIMB_SIMD_
+#define FDS_LIMB_SIMD_
+
+#include <cstdint>
+#include <cstddef>
+
+// 在 x86 上使用 GCC / Clang 编译时启用向量化内核，定义 FDS_NO_SIMD 可以强制只使用标量实现
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(FDS_NO_SIMD)
+#define FDS_LIMB_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// 按块运算的向量化内核
+// 运行时检测 CPU 支持的指令集（AVX2 / AVX-512），选择对应的实现，都不支持时使用标量实现
+// 向量化只针对 64 位块；32 位块的重载是标量实现，只为了让调用方的代码统一
+//
+// 批量加减使用“结构数组”布局：lanes 个互相独立的数的第 j 块连续存放，即 x[j * lanes + i] 为第 i 个数的第 j 块
+// 每个 SIMD 通道负责一个数，各自的进位链互不影响，因此可以同时处理 4 个（AVX2）或 8 个（AVX-512）数
+// carry[i] 为第 i 个数的进位（借位），调用前是低位传来的进位，调用后是向更高位的进位，因此一个数可以分成若干段依次计算
+struct LimbSimd {
+  enum Level { SCALAR = 0, AVX2 = 1, AVX512 = 2 };
+
+ public: // 指令集级别
+  static auto detected_level() -> Level; // CPU 支持的最高级别
+  static auto level() -> Level; // 当前使用的级别
+  static auto set_level(Level level) -> Level; // 指定使用的级别（不会超过 CPU 支持的级别），返回实际使用的级别
+
+ public: // 批量加减：out = a ± b，每个数 n 块，共 lanes 个数，out 可以与 a、b 相同
+  static auto add_lanes(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> void;
+  static auto sub_lanes(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> void;
+  static auto add_lanes(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *out, std::uint32_t *carry, std::size_t n, std::size_t lanes) -> void;
+  static auto sub_lanes(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *out, std::uint32_t *carry, std::size_t n, std::size_t lanes) -> void;
+
+ public: // 两个 n 块的数比较：equal 判断是否相等，compare 从高位到低位比较，返回 -1、0 或 1
+  static auto equal(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> bool;
+  static auto compare(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> int;
+  static auto equal(const std::uint32_t *a, const std::uint32_t *b, std::size_t n) -> bool;
+  static auto compare(const std::uint32_t *a, const std::uint32_t *b, std::size_t n) -> int;
+
+ private: // 当前使用的级别
+  static auto current() -> Level&;
+
+ private: // 标量实现
+  template <class Limb>
+  static auto add_lanes_scalar(const Limb *a, const Limb *b, Limb *out, Limb *carry, std::size_t n, std::size_t lanes, std::size_t first) -> void;
+  template <class Limb>
+  static auto sub_lanes_scalar(const Limb *a, const Limb *b, Limb *out, Limb *carry, std::size_t n, std::size_t lanes, std::size_t first) -> void;
+  template <class Limb>
+  static auto compare_scalar(const Limb *a, const Limb *b, std::size_t n) -> int;
+
+#ifdef FDS_LIMB_SIMD_X86
+ private: // 向量化实现，返回已经处理的通道数，剩下的通道交给标量实现
+  static auto add_lanes_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t;
+  static auto sub_lanes_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t;
+  static auto add_lanes_avx512(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t;
+  static auto sub_lanes_avx512(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t;
+  static auto compare_avx2(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> int;
+  static auto equal_avx2(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> bool;
+#endif
+};
+
+#endif //FDS_LIMB_SIMD_
+
+#include "limb_simd_impl.h"
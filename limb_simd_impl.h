@@ -0,0 +1,273 @@
+#ifndef FDS_LIMB_SIMD_IMPL_
+#define FDS_LIMB_SIMD_IMPL_
+
+#include "limb_simd.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 指令集级别
+
+inline auto LimbSimd::detected_level() -> Level {
+#ifdef FDS_LIMB_SIMD_X86
+  static const Level detected = __builtin_cpu_supports("avx512f") ? AVX512
+                              : __builtin_cpu_supports("avx2") ? AVX2 : SCALAR;
+  return detected;
+#else
+  return SCALAR;
+#endif
+}
+
+inline auto LimbSimd::current() -> Level& {
+  static Level level = detected_level();
+  return level;
+}
+
+inline auto LimbSimd::level() -> Level { return current(); }
+
+inline auto LimbSimd::set_level(Level level) -> Level {
+  return current() = level < detected_level() ? level : detected_level();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 批量加减
+
+inline auto LimbSimd::add_lanes(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> void {
+  std::size_t done = 0;
+#ifdef FDS_LIMB_SIMD_X86
+  if (current() == AVX512)
+    done = add_lanes_avx512(a, b, out, carry, n, lanes);
+  else if (current() == AVX2)
+    done = add_lanes_avx2(a, b, out, carry, n, lanes);
+#endif
+  add_lanes_scalar(a, b, out, carry, n, lanes, done);
+}
+
+inline auto LimbSimd::sub_lanes(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> void {
+  std::size_t done = 0;
+#ifdef FDS_LIMB_SIMD_X86
+  if (current() == AVX512)
+    done = sub_lanes_avx512(a, b, out, carry, n, lanes);
+  else if (current() == AVX2)
+    done = sub_lanes_avx2(a, b, out, carry, n, lanes);
+#endif
+  sub_lanes_scalar(a, b, out, carry, n, lanes, done);
+}
+
+inline auto LimbSimd::add_lanes(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *out, std::uint32_t *carry, std::size_t n, std::size_t lanes) -> void {
+  add_lanes_scalar(a, b, out, carry, n, lanes, 0);
+}
+
+inline auto LimbSimd::sub_lanes(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *out, std::uint32_t *carry, std::size_t n, std::size_t lanes) -> void {
+  sub_lanes_scalar(a, b, out, carry, n, lanes, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 比较
+
+inline auto LimbSimd::equal(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> bool {
+#ifdef FDS_LIMB_SIMD_X86
+  if (current() != SCALAR)
+    return equal_avx2(a, b, n);
+#endif
+  return compare_scalar(a, b, n) == 0;
+}
+
+inline auto LimbSimd::compare(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> int {
+#ifdef FDS_LIMB_SIMD_X86
+  if (current() != SCALAR)
+    return compare_avx2(a, b, n);
+#endif
+  return compare_scalar(a, b, n);
+}
+
+inline auto LimbSimd::equal(const std::uint32_t *a, const std::uint32_t *b, std::size_t n) -> bool {
+  return compare_scalar(a, b, n) == 0;
+}
+
+inline auto LimbSimd::compare(const std::uint32_t *a, const std::uint32_t *b, std::size_t n) -> int {
+  return compare_scalar(a, b, n);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 标量实现：处理 [first, lanes) 这些通道
+
+template<class Limb>
+auto LimbSimd::add_lanes_scalar(const Limb *a, const Limb *b, Limb *out, Limb *carry, std::size_t n, std::size_t lanes, std::size_t first) -> void {
+  for (std::size_t i = first; i < lanes; ++i) {
+    Limb c = carry[i];
+    for (std::size_t j = 0; j < n; ++j) {
+      Limb x = a[j * lanes + i], s = x + b[j * lanes + i];
+      Limb d = s < x;
+      s += c;
+      c = d | (s < c);
+      out[j * lanes + i] = s;
+    }
+    carry[i] = c;
+  }
+}
+
+template<class Limb>
+auto LimbSimd::sub_lanes_scalar(const Limb *a, const Limb *b, Limb *out, Limb *carry, std::size_t n, std::size_t lanes, std::size_t first) -> void {
+  for (std::size_t i = first; i < lanes; ++i) {
+    Limb c = carry[i];
+    for (std::size_t j = 0; j < n; ++j) {
+      Limb x = a[j * lanes + i], y = b[j * lanes + i], d = x - y;
+      Limb e = x < y;
+      out[j * lanes + i] = d - c;
+      c = e | (d < c);
+    }
+    carry[i] = c;
+  }
+}
+
+template<class Limb>
+auto LimbSimd::compare_scalar(const Limb *a, const Limb *b, std::size_t n) -> int {
+  for (std::size_t i = n; i > 0; --i) {
+    if (a[i - 1] != b[i - 1])
+      return a[i - 1] < b[i - 1] ? -1 : 1;
+  }
+  return 0;
+}
+
+#ifdef FDS_LIMB_SIMD_X86
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// AVX2 实现
+// AVX2 没有无符号比较，把两边的最高位取反后用有符号比较代替
+
+__attribute__((target("avx2")))
+inline auto LimbSimd::add_lanes_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t {
+  const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+  std::size_t i = 0;
+
+  for (; i + 4 <= lanes; i += 4) {
+    __m256i c0 = _mm256_loadu_si256((const __m256i*)(carry + i)); // 每个通道为 0 或 1
+    for (std::size_t j = 0; j < n; ++j) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(a + j * lanes + i));
+      __m256i y = _mm256_loadu_si256((const __m256i*)(b + j * lanes + i));
+      __m256i s = _mm256_add_epi64(x, y);
+      // s < x 时产生进位，比较结果为全 1（即 -1）
+      __m256i c = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(s, sign));
+      __m256i t = _mm256_add_epi64(s, c0);
+      // 加上进位后回绕为 0 时同样产生进位
+      __m256i d = _mm256_cmpgt_epi64(_mm256_xor_si256(c0, sign), _mm256_xor_si256(t, sign));
+      _mm256_storeu_si256((__m256i*)(out + j * lanes + i), t);
+      c0 = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_or_si256(c, d));
+    }
+    _mm256_storeu_si256((__m256i*)(carry + i), c0);
+  }
+
+  return i;
+}
+
+__attribute__((target("avx2")))
+inline auto LimbSimd::sub_lanes_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t {
+  const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+  std::size_t i = 0;
+
+  for (; i + 4 <= lanes; i += 4) {
+    __m256i borrow = _mm256_loadu_si256((const __m256i*)(carry + i)); // 每个通道为 0 或 1
+    for (std::size_t j = 0; j < n; ++j) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(a + j * lanes + i));
+      __m256i y = _mm256_loadu_si256((const __m256i*)(b + j * lanes + i));
+      __m256i d = _mm256_sub_epi64(x, y);
+      // x < y 时产生借位
+      __m256i c = _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+      // d < borrow 时减去借位会再次借位
+      __m256i e = _mm256_cmpgt_epi64(_mm256_xor_si256(borrow, sign), _mm256_xor_si256(d, sign));
+      _mm256_storeu_si256((__m256i*)(out + j * lanes + i), _mm256_sub_epi64(d, borrow));
+      borrow = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_or_si256(c, e));
+    }
+    _mm256_storeu_si256((__m256i*)(carry + i), borrow);
+  }
+
+  return i;
+}
+
+__attribute__((target("avx2")))
+inline auto LimbSimd::equal_avx2(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> bool {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(x, y)) != -1)
+      return false;
+  }
+  for (; i < n; ++i) {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+__attribute__((target("avx2")))
+inline auto LimbSimd::compare_avx2(const std::uint64_t *a, const std::uint64_t *b, std::size_t n) -> int {
+  // 从最高位开始每次比较 4 块，找到不同的一组后再取其中最高的不同块
+  std::size_t i = n;
+  for (; i >= 4; i -= 4) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i - 4));
+    __m256i y = _mm256_loadu_si256((const __m256i*)(b + i - 4));
+    int diff = ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, y))) & 0xf;
+    if (diff != 0) {
+      std::size_t k = i - 4 + (std::size_t)(31 - __builtin_clz((unsigned)diff));
+      return a[k] < b[k] ? -1 : 1;
+    }
+  }
+  return compare_scalar(a, b, i);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// AVX-512 实现
+// 直接使用无符号比较得到的掩码，进位通过带掩码的加法加上去
+
+__attribute__((target("avx512f")))
+inline auto LimbSimd::add_lanes_avx512(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t {
+  const __m512i one = _mm512_set1_epi64(1);
+  std::size_t i = 0;
+
+  for (; i + 8 <= lanes; i += 8) {
+    __mmask8 c0 = _mm512_test_epi64_mask(_mm512_loadu_si512((const void*)(carry + i)), one);
+    for (std::size_t j = 0; j < n; ++j) {
+      __m512i x = _mm512_loadu_si512((const void*)(a + j * lanes + i));
+      __m512i y = _mm512_loadu_si512((const void*)(b + j * lanes + i));
+      __m512i s = _mm512_add_epi64(x, y);
+      __mmask8 c = _mm512_cmplt_epu64_mask(s, x);
+      __m512i t = _mm512_mask_add_epi64(s, c0, s, one);
+      // 带进位且加上后回绕为 0
+      __mmask8 d = _mm512_mask_cmpeq_epu64_mask(c0, t, _mm512_setzero_si512());
+      _mm512_storeu_si512((void*)(out + j * lanes + i), t);
+      c0 = (__mmask8)(c | d);
+    }
+    _mm512_storeu_si512((void*)(carry + i), _mm512_maskz_mov_epi64(c0, one));
+  }
+
+  return i;
+}
+
+__attribute__((target("avx512f")))
+inline auto LimbSimd::sub_lanes_avx512(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::uint64_t *carry, std::size_t n, std::size_t lanes) -> std::size_t {
+  const __m512i one = _mm512_set1_epi64(1);
+  std::size_t i = 0;
+
+  for (; i + 8 <= lanes; i += 8) {
+    __mmask8 borrow = _mm512_test_epi64_mask(_mm512_loadu_si512((const void*)(carry + i)), one);
+    for (std::size_t j = 0; j < n; ++j) {
+      __m512i x = _mm512_loadu_si512((const void*)(a + j * lanes + i));
+      __m512i y = _mm512_loadu_si512((const void*)(b + j * lanes + i));
+      __m512i d = _mm512_sub_epi64(x, y);
+      __mmask8 c = _mm512_cmplt_epu64_mask(x, y);
+      // 带借位且差为 0 时减去借位会再次借位
+      __mmask8 e = _mm512_mask_cmpeq_epu64_mask(borrow, d, _mm512_setzero_si512());
+      _mm512_storeu_si512((void*)(out + j * lanes + i), _mm512_mask_sub_epi64(d, borrow, d, one));
+      borrow = (__mmask8)(c | e);
+    }
+    _mm512_storeu_si512((void*)(carry + i), _mm512_maskz_mov_epi64(borrow, one));
+  }
+
+  return i;
+}
+
+#endif // FDS_LIMB_SIMD_X86
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_LIMB_SIMD_IMPL_
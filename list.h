@@ -2,6 +2,12 @@
 #define FDS_LIST_
 
 #include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // 双向循环链表节点定义
 template <class T>
@@ -9,6 +15,7 @@ struct ListNode {
   T data;
   ListNode *next, *prev;
   explicit ListNode(const T& val);
+  explicit ListNode(T&& val);
 };
 
 // 双向循环链表迭代器定义
@@ -35,26 +42,124 @@ class ListIterator {
   auto raw() -> ListNode<T>*;
 };
 
+// 链表节点的分配统计，每个线程各一份
+// 只有定义了 FDS_LIST_ALLOC_STATS 时 List 才会更新这些计数，否则没有任何额外开销
+struct ListAllocStats {
+  std::size_t live_nodes = 0;        // 当前存活的节点数（包括头节点）
+  std::size_t peak_nodes = 0;        // 存活节点数的峰值
+  std::size_t total_allocations = 0; // 累计分配的节点数
+
+  auto reset() -> void; // 峰值重新从当前存活数开始统计，累计分配数清零
+  static auto local() -> ListAllocStats&; // 当前线程的统计数据
+};
+
+// 链表节点的内存池：每次向全局分配器申请一整块，释放的节点串成空闲链表重复使用
+// 默认分配器使用的是每个线程各一份的内存池，线程结束时它的内存块和空闲节点全部交给进程级的内存池，不会释放
+// 因此节点可以比分配它的线程活得更久（例如静态链表、在其他线程上构造的链表），新线程的内存池用完时也会先取回进程级内存池中的空闲节点
+template <class T>
+class ListNodePool {
+  union Slot { // 空闲时存放下一个空闲节点，使用时存放节点本身
+    Slot *next;
+    alignas(ListNode<T>) unsigned char storage[sizeof(ListNode<T>)];
+  };
+
+  Slot *free_list;
+  std::vector<Slot*> chunks;
+  std::size_t chunk_size; // 每次申请的节点个数
+  bool draw_shared;       // 空闲链表用完时是否先从进程级内存池取回空闲节点，只有线程局部的内存池为 true
+
+ public: // 构造与析构函数，析构时归还所有申请过的内存
+  explicit ListNodePool(std::size_t chunk_size = 256);
+  ListNodePool(const ListNodePool &other) = delete;
+  auto operator=(const ListNodePool &other) -> ListNodePool& = delete;
+  ~ListNodePool();
+
+ public: // 分配与回收一个节点的内存（不负责构造与析构）
+  auto allocate() -> ListNode<T>*;
+  auto deallocate(ListNode<T> *p) -> void;
+
+ public: // 当前线程的内存池，线程结束之后（例如静态对象析构时）返回 nullptr，此时应当持有 shared_mutex() 使用 shared()
+  static auto local() -> ListNodePool*;
+
+ public: // 进程级的内存池和保护它的锁，二者都不会被析构
+  static auto shared() -> ListNodePool&;
+  static auto shared_mutex() -> std::mutex&;
+
+ private: // 接管 other 的全部内存块和空闲节点
+  auto adopt(ListNodePool &other) -> void;
+};
+
+// 区域分配：只分配不回收，在析构或 release 时一次性释放所有节点
+// 使用它的链表必须先于区域析构，或者之后不再使用
 template <class T>
+class ListArena {
+  typedef typename std::aligned_storage<sizeof(ListNode<T>), alignof(ListNode<T>)>::type Slot;
+
+  std::vector<Slot*> chunks;
+  std::size_t chunk_size; // 每次申请的节点个数
+  std::size_t used;       // 最后一块中已经分配出去的节点个数
+
+ public: // 构造与析构函数
+  explicit ListArena(std::size_t chunk_size = 1024);
+  ListArena(const ListArena &other) = delete;
+  auto operator=(const ListArena &other) -> ListArena& = delete;
+  ~ListArena();
+
+ public: // 分配一个节点的内存，释放全部内存
+  auto allocate() -> ListNode<T>*;
+  auto release() -> void;
+};
+
+// 默认的节点分配器：使用当前线程的 ListNodePool，线程结束之后加锁使用进程级的内存池
+template <class T>
+struct ListPoolAllocator {
+  auto allocate() -> ListNode<T>*;
+  auto deallocate(ListNode<T> *p) -> void;
+};
+
+// 从指定的 ListArena 中分配节点，单个节点的回收不做任何事
+template <class T>
+class ListArenaAllocator {
+  ListArena<T> *arena;
+
+ public:
+  explicit ListArenaAllocator(ListArena<T> &arena);
+  auto allocate() -> ListNode<T>*;
+  auto deallocate(ListNode<T> *p) -> void;
+};
+
+// 双向循环链表，节点的内存由 Alloc 提供（需要有 allocate() 和 deallocate(ListNode<T>*)）
+template <class T, class Alloc = ListPoolAllocator<T>>
 class List {
- public: // 头节点和大小
+ public: // 头节点和大小，被移走的链表没有头节点（node 为 nullptr），此时 begin() 与 end() 都是空迭代器
   ListNode<T> *node;
   std::size_t siz;
 
+ private: // 节点分配器
+  Alloc alloc;
+
+ private: // 节点的创建与销毁
+  auto _create_node(const T &val) -> ListNode<T>*;
+  auto _create_node(T &&val) -> ListNode<T>*;
+  auto _free_node(ListNode<T> *p) -> void;
+  auto _link_node(ListIterator<T> pos, ListNode<T> *p) -> ListIterator<T>; // 把已经创建好的节点接在 pos 前面
+
  private: // 头节点操作
   void _init_node();
   void _destroy_node();
 
  public: // 构造与析构函数
-  List();
-  explicit List(std::size_t count, const T& value = T());
+  explicit List(const Alloc &alloc = Alloc());
+  explicit List(std::size_t count, const T& value = T(), const Alloc &alloc = Alloc());
   List(const List &other);
+  List(List &&other) noexcept; // other 不再持有头节点，之后第一次插入时再创建
   ~List();
   auto reconstruct(const List &other) -> void;
   auto reconstruct(std::size_t count, const T& value) -> void;
 
- public: // 拷贝与交换
-  auto operator=(const List &other) -> List& = delete;
+ public: // 拷贝、移动与交换
+  auto operator=(const List &other) -> List&;
+  auto operator=(List &&other) noexcept -> List&;
   auto swap(List &other) -> void;
   auto swap(List &&other) -> void;
 
@@ -77,32 +182,40 @@ class List {
  public: // 链表插入、删除、清空
   auto clear() -> void;
   auto insert(ListIterator<T> pos, const T &val) -> ListIterator<T>; // 在指定迭代器前面插入元素
+  auto insert(ListIterator<T> pos, T &&val) -> ListIterator<T>;
   auto erase(ListIterator<T> pos) -> ListIterator<T>; // 基于迭代器删除元素
   auto erase(const T& val) -> std::size_t; // 基于权值删除元素
 
  public: // 头尾增删元素
   auto push_back(const T& val) -> void;
+  auto push_back(T&& val) -> void;
   auto push_front(const T& val) -> void;
+  auto push_front(T&& val) -> void;
   auto pop_back() -> void;
   auto pop_front() -> void;
 
- public: // 链表分裂为 [first, pos), [pos, last)
-  auto split(std::size_t pos) const -> std::pair<List<T>, List<T>>;
+ public: // 链表分裂为 [first, pos), [pos, last)，右值版本直接把节点分给两个链表，不复制元素
+  auto split(std::size_t pos) const & -> std::pair<List, List>;
+  auto split(std::size_t pos) && -> std::pair<List, List>;
+
+ public: // 获取节点分配器
+  auto get_allocator() const -> Alloc;
 
- public: // 两个链表的拼接
-  auto merge(const List<T> &other) -> void;
-  auto operator+(const List<T> &other) -> List<T>;
-  auto operator+=(const List<T> &other) -> List<T>&;
+ public: // 两个链表的拼接，左侧为右值时直接在它的节点后面追加
+  auto merge(const List &other) -> void;
+  auto operator+(const List &other) const & -> List;
+  auto operator+(const List &other) && -> List;
+  auto operator+=(const List &other) -> List&;
 
  public: // 比较是否相等
-  auto operator==(const List<T> &other) const -> bool;
-  auto operator!=(const List<T> &other) const -> bool;
+  auto operator==(const List &other) const -> bool;
+  auto operator!=(const List &other) const -> bool;
 
  public: // 比较字典序
-  auto operator<(const List<T> &other) const -> bool;
-  auto operator>=(const List<T> &other) const -> bool;
-  auto operator>(const List<T> &other) const -> bool;
-  auto operator<=(const List<T> &other) const -> bool;
+  auto operator<(const List &other) const -> bool;
+  auto operator>=(const List &other) const -> bool;
+  auto operator>(const List &other) const -> bool;
+  auto operator<=(const List &other) const -> bool;
 };
 
 #endif //FDS_LIST_
@@ -8,6 +8,8 @@
 
 template<class T>
 inline ListNode<T>::ListNode(const T &val) : data(val) {}
+template<class T>
+inline ListNode<T>::ListNode(T &&val) : data(std::move(val)) {}
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // ListIterator 构造函数实现
@@ -64,169 +66,411 @@ template<class T>
 inline auto ListIterator<T>::raw() -> ListNode<T> * { return node; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// List 头节点辅助函数实现
+// ListAllocStats 实现
+
+inline auto ListAllocStats::reset() -> void {
+  peak_nodes = live_nodes;
+  total_allocations = 0;
+}
+
+inline auto ListAllocStats::local() -> ListAllocStats& {
+  thread_local ListAllocStats stats;
+  return stats;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// ListNodePool 实现
 
 template<class T>
-inline auto List<T>::_init_node() -> void { // 构造头节点
-  node = new ListNode<T>(T());
-  node->next = node;
-  node->prev = node;
+ListNodePool<T>::ListNodePool(std::size_t chunk_size) : free_list(nullptr), chunk_size(chunk_size), draw_shared(false) {}
+
+template<class T>
+ListNodePool<T>::~ListNodePool() {
+  for (Slot *chunk : chunks)
+    ::operator delete(chunk);
+}
+
+template<class T>
+auto ListNodePool<T>::allocate() -> ListNode<T>* {
+  if (free_list == nullptr && draw_shared) {
+    // 先取回已经结束的线程留下的空闲节点，内存块仍然归进程级内存池所有
+    std::lock_guard<std::mutex> lock(shared_mutex());
+    free_list = shared().free_list;
+    shared().free_list = nullptr;
+  }
+  if (free_list == nullptr) {
+    // 空闲链表用完时申请一整块，并把其中的节点全部串进空闲链表
+    auto *chunk = static_cast<Slot*>(::operator new(sizeof(Slot) * chunk_size));
+    chunks.push_back(chunk);
+    for (std::size_t i = 0; i < chunk_size; ++i)
+      chunk[i].next = i + 1 < chunk_size ? &chunk[i + 1] : nullptr;
+    free_list = chunk;
+  }
+
+  Slot *slot = free_list;
+  free_list = slot->next;
+  return reinterpret_cast<ListNode<T>*>(slot->storage);
+}
+
+template<class T>
+auto ListNodePool<T>::deallocate(ListNode<T> *p) -> void {
+  auto *slot = reinterpret_cast<Slot*>(p);
+  slot->next = free_list;
+  free_list = slot;
+}
+
+// 线程局部的内存池放在 Holder 中，线程结束时 Holder 析构，把全部内存交给进程级的内存池，并把 current 置空
+// current 和 exited 是平凡析构的 thread_local，线程结束之后仍然可以读取，Holder 析构之后不会再被构造
+template<class T>
+auto ListNodePool<T>::local() -> ListNodePool* {
+  struct Holder {
+    ListNodePool pool;
+    ListNodePool **current;
+    bool *exited;
+
+    Holder(ListNodePool **current, bool *exited) : current(current), exited(exited) {
+      pool.draw_shared = true;
+      *current = &pool;
+    }
+    ~Holder() {
+      std::lock_guard<std::mutex> lock(shared_mutex());
+      shared().adopt(pool);
+      *current = nullptr, *exited = true;
+    }
+  };
+
+  thread_local ListNodePool *current = nullptr;
+  thread_local bool exited = false;
+  if (current == nullptr && !exited) {
+    thread_local Holder holder(&current, &exited);
+  }
+  return current;
+}
+
+template<class T>
+auto ListNodePool<T>::shared() -> ListNodePool& {
+  static ListNodePool *pool = new ListNodePool(); // 有意不释放，静态对象析构时仍可能使用
+  return *pool;
+}
+
+template<class T>
+auto ListNodePool<T>::shared_mutex() -> std::mutex& {
+  static std::mutex *mutex = new std::mutex();
+  return *mutex;
+}
+
+template<class T>
+auto ListNodePool<T>::adopt(ListNodePool &other) -> void {
+  chunks.insert(chunks.end(), other.chunks.begin(), other.chunks.end());
+  other.chunks.clear();
+
+  // 把 other 的空闲链表接在自己的前面
+  if (other.free_list != nullptr) {
+    Slot *tail = other.free_list;
+    while (tail->next != nullptr)
+      tail = tail->next;
+    tail->next = free_list;
+    free_list = other.free_list;
+    other.free_list = nullptr;
+  }
 }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// ListArena 实现
+
+template<class T>
+ListArena<T>::ListArena(std::size_t chunk_size) : chunk_size(chunk_size), used(chunk_size) {}
+
+template<class T>
+ListArena<T>::~ListArena() { release(); }
+
 template<class T>
-inline auto List<T>::_destroy_node() -> void { // 销毁头节点
-  delete node;
+auto ListArena<T>::allocate() -> ListNode<T>* {
+  if (used == chunk_size) {
+    chunks.push_back(static_cast<Slot*>(::operator new(sizeof(Slot) * chunk_size)));
+    used = 0;
+  }
+  return reinterpret_cast<ListNode<T>*>(&chunks.back()[used++]);
+}
+
+template<class T>
+auto ListArena<T>::release() -> void {
+  for (Slot *chunk : chunks)
+    ::operator delete(chunk);
+  chunks.clear();
+  used = chunk_size;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// List 构造函数和析构函数实现
+// 节点分配器实现
 
 template<class T>
-inline List<T>::List() : siz() { _init_node(); } // 构造函数
+inline auto ListPoolAllocator<T>::allocate() -> ListNode<T>* {
+  if (ListNodePool<T> *pool = ListNodePool<T>::local())
+    return pool->allocate();
+  std::lock_guard<std::mutex> lock(ListNodePool<T>::shared_mutex());
+  return ListNodePool<T>::shared().allocate();
+}
+template<class T>
+inline auto ListPoolAllocator<T>::deallocate(ListNode<T> *p) -> void {
+  if (ListNodePool<T> *pool = ListNodePool<T>::local())
+    return pool->deallocate(p);
+  std::lock_guard<std::mutex> lock(ListNodePool<T>::shared_mutex());
+  ListNodePool<T>::shared().deallocate(p);
+}
 
 template<class T>
-List<T>::List(std::size_t count, const T &value) : siz() { // 构造函数
+inline ListArenaAllocator<T>::ListArenaAllocator(ListArena<T> &arena) : arena(&arena) {}
+template<class T>
+inline auto ListArenaAllocator<T>::allocate() -> ListNode<T>* { return arena->allocate(); }
+template<class T>
+inline auto ListArenaAllocator<T>::deallocate(ListNode<T> *) -> void {} // 由 ListArena 统一释放
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// List 节点的创建与销毁
+
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_create_node(const T &val) -> ListNode<T>* {
+  ListNode<T> *p = alloc.allocate();
+  new (p) ListNode<T>(val);
+#ifdef FDS_LIST_ALLOC_STATS
+  ListAllocStats &stats = ListAllocStats::local();
+  ++stats.total_allocations;
+  if (++stats.live_nodes > stats.peak_nodes)
+    stats.peak_nodes = stats.live_nodes;
+#endif
+  return p;
+}
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_create_node(T &&val) -> ListNode<T>* {
+  ListNode<T> *p = alloc.allocate();
+  new (p) ListNode<T>(std::move(val));
+#ifdef FDS_LIST_ALLOC_STATS
+  ListAllocStats &stats = ListAllocStats::local();
+  ++stats.total_allocations;
+  if (++stats.live_nodes > stats.peak_nodes)
+    stats.peak_nodes = stats.live_nodes;
+#endif
+  return p;
+}
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_free_node(ListNode<T> *p) -> void {
+  p->~ListNode<T>();
+  alloc.deallocate(p);
+#ifdef FDS_LIST_ALLOC_STATS
+  --ListAllocStats::local().live_nodes;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// List 头节点辅助函数实现
+
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_init_node() -> void { // 构造头节点
+  node = _create_node(T());
+  node->next = node;
+  node->prev = node;
+}
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_destroy_node() -> void { // 销毁头节点
+  _free_node(node);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// List 构造函数和析构函数实现
+
+template<class T, class Alloc>
+inline List<T, Alloc>::List(const Alloc &alloc) : siz(), alloc(alloc) { _init_node(); } // 构造函数
+
+template<class T, class Alloc>
+List<T, Alloc>::List(std::size_t count, const T &value, const Alloc &alloc) : siz(), alloc(alloc) { // 构造函数
   _init_node();
   for (std::size_t i = 0; i < count; ++i) {
     push_back(value);
   }
 }
 
-template<class T>
-List<T>::List(const List &other) : siz() { // 复制构造函数
+template<class T, class Alloc>
+List<T, Alloc>::List(const List &other) : siz(), alloc(other.alloc) { // 复制构造函数，与 other 使用同一个分配器
   _init_node();
   for (ListIterator<T> it = other.begin(); it != other.end(); ++it) {
     push_back(*it);
   }
 }
 
-template<class T>
-inline List<T>::~List() { // 析构函数
-  _destroy_node();
+template<class T, class Alloc>
+List<T, Alloc>::List(List &&other) noexcept : node(other.node), siz(other.siz), alloc(other.alloc) { // 移动构造函数，直接接管节点，不分配任何内存
+  other.node = nullptr;
+  other.siz = 0;
 }
 
-template<class T>
-auto List<T>::reconstruct(const List &other) -> void {
+template<class T, class Alloc>
+inline List<T, Alloc>::~List() { // 析构函数，先释放所有元素节点再释放头节点
+  if (node != nullptr) {
+    clear();
+    _destroy_node();
+  }
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::reconstruct(const List &other) -> void {
   this->~List();
   new (this)List(other);
 }
 
-template<class T>
-auto List<T>::reconstruct(std::size_t count, const T& value) -> void {
+template<class T, class Alloc>
+auto List<T, Alloc>::reconstruct(std::size_t count, const T& value) -> void {
+  Alloc a = alloc;
   this->~List();
-  new (this)List(count, value);
+  new (this)List(count, value, a);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-// List 拷贝（禁止拷贝）与交换
+// List 拷贝、移动与交换
 
-template<class T>
-auto List<T>::swap(List &other) -> void { std::swap(node, other.node), std::swap(siz, other.siz); }
+template<class T, class Alloc>
+auto List<T, Alloc>::swap(List &other) -> void { std::swap(node, other.node), std::swap(siz, other.siz), std::swap(alloc, other.alloc); }
 
-template<class T>
-auto List<T>::swap(List &&other) -> void {
+template<class T, class Alloc>
+auto List<T, Alloc>::swap(List &&other) -> void {
   std::swap(node, other.node);
   std::swap(siz, other.siz);
+  std::swap(alloc, other.alloc);
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::operator=(const List &other) -> List& { // 拷贝赋值，先复制再交换，复制失败时不影响原链表
+  if (this != &other) {
+    List tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::operator=(List &&other) noexcept -> List& { // 移动赋值，原有节点交给 other 释放
+  swap(other);
+  return *this;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 取头尾元素实现
 
-template<class T>
-inline auto List<T>::front() -> T& { return *begin(); }
-template<class T>
-inline auto List<T>::front() const -> const T& { return *begin(); }
-template<class T>
-inline auto List<T>::back() -> T& { return *(--end()); }
-template<class T>
-inline auto List<T>::back() const -> const T& { return *(--end()); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::front() -> T& { return *begin(); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::front() const -> const T& { return *begin(); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::back() -> T& { return *(--end()); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::back() const -> const T& { return *(--end()); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // ListIterator 取头尾迭代器实现
 
-template<class T>
-inline auto List<T>::begin() -> ListIterator<T> { return ListIterator<T>(node->next); }
-template<class T>
-inline auto List<T>::begin() const -> const ListIterator<T> { return ListIterator<T>(node->next); }
-template<class T>
-inline auto List<T>::end() -> ListIterator<T> { return ListIterator<T>(node); }
-template<class T>
-inline auto List<T>::end() const -> const ListIterator<T> { return ListIterator<T>(node); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::begin() -> ListIterator<T> { return ListIterator<T>(node != nullptr ? node->next : nullptr); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::begin() const -> const ListIterator<T> { return ListIterator<T>(node != nullptr ? node->next : nullptr); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::end() -> ListIterator<T> { return ListIterator<T>(node); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::end() const -> const ListIterator<T> { return ListIterator<T>(node); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 容量相关，判空与获取大小
 
-template<class T>
-inline auto List<T>::empty() const -> bool { return node->next == node; }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::empty() const -> bool { return node == nullptr || node->next == node; }
 
-template<class T>
-auto List<T>::size() const -> std::size_t { return siz; }
+template<class T, class Alloc>
+auto List<T, Alloc>::size() const -> std::size_t { return siz; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 主要操作，插入、删除、清空等
 
-template<class T>
-auto List<T>::clear() -> void { // 清空链表
+template<class T, class Alloc>
+auto List<T, Alloc>::clear() -> void { // 清空链表
+  if (node == nullptr)
+    return;
   ListNode<T> *cur = node->next;
   while (cur != node) {
+    // 节点回到内存池后内容可能被覆盖，先取出下一个节点再释放
     ListNode<T> *tmp = cur;
-    delete tmp;
     cur = cur->next;
+    _free_node(tmp);
   }
   node->next = node->prev = node;
   siz = 0;
 }
 
-template<class T>
-auto List<T>::insert(ListIterator<T> pos, const T &val) -> ListIterator<T> { // 在指定位置前插入元素
-  auto *tmp = new ListNode<T>(val);
-  tmp->next = pos.raw();
-  tmp->prev = pos.raw()->prev;
-  pos.raw()->prev->next = tmp;
-  pos.raw()->prev = tmp;
+template<class T, class Alloc>
+auto List<T, Alloc>::insert(ListIterator<T> pos, const T &val) -> ListIterator<T> { // 在指定位置前插入元素
+  if (node == nullptr) // 被移走的链表此时才创建头节点，pos 只能是 begin() 或 end()
+    _init_node(), pos = end();
+  return _link_node(pos, _create_node(val));
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::insert(ListIterator<T> pos, T &&val) -> ListIterator<T> { // 在指定位置前插入元素，元素直接移入节点
+  if (node == nullptr)
+    _init_node(), pos = end();
+  return _link_node(pos, _create_node(std::move(val)));
+}
+
+template<class T, class Alloc>
+inline auto List<T, Alloc>::_link_node(ListIterator<T> pos, ListNode<T> *p) -> ListIterator<T> {
+  p->next = pos.raw();
+  p->prev = pos.raw()->prev;
+  pos.raw()->prev->next = p;
+  pos.raw()->prev = p;
   ++siz;
-  return ListIterator<T>(tmp);
+  return ListIterator<T>(p);
 }
 
-template<class T>
-auto List<T>::erase(ListIterator<T> pos) -> ListIterator<T> { // 删除指定位置元素
+template<class T, class Alloc>
+auto List<T, Alloc>::erase(ListIterator<T> pos) -> ListIterator<T> { // 删除指定位置元素
   ListNode<T> *next_node = pos.raw()->next,
       *prev_node = pos.raw()->prev,
       *curr_node = pos.raw();
   next_node->prev = prev_node;
   prev_node->next = next_node;
-  delete curr_node;
+  _free_node(curr_node);
   --siz;
   return ListIterator<T>(next_node);
 }
 
-template<class T>
-auto List<T>::erase(const T &val) -> std::size_t { // 按权值删除元素
+template<class T, class Alloc>
+auto List<T, Alloc>::erase(const T &val) -> std::size_t { // 按权值删除元素
   std::size_t count = 0;
   for (ListIterator<T> it = begin(); it != end(); ) {
     if (val == *it)
       it = erase(it), ++count;
     else ++it;
   }
-  --siz;
   return count;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 在头尾插入删除实现
 
-template<class T>
-inline auto List<T>::push_back(const T &val) -> void { insert(end(), val); }
-template<class T>
-inline auto List<T>::push_front(const T &val) -> void { insert(begin(), val); }
-template<class T>
-inline auto List<T>::pop_back() -> void { erase(--end()); }
-template<class T>
-inline auto List<T>::pop_front() -> void { erase(begin()); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::push_back(const T &val) -> void { insert(end(), val); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::push_back(T &&val) -> void { insert(end(), std::move(val)); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::push_front(const T &val) -> void { insert(begin(), val); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::push_front(T &&val) -> void { insert(begin(), std::move(val)); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::pop_back() -> void { erase(--end()); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::pop_front() -> void { erase(begin()); }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-template<class T>
-auto List<T>::split(std::size_t pos) const -> std::pair<List<T>, List<T>> {
-  List<unsigned> p1, p2;
+template<class T, class Alloc>
+auto List<T, Alloc>::split(std::size_t pos) const & -> std::pair<List, List> {
+  List p1(alloc), p2(alloc);
   std::size_t siz = size();
   auto it = begin();
 
@@ -237,28 +481,61 @@ auto List<T>::split(std::size_t pos) const -> std::pair<List<T>, List<T>> {
     p2.push_back(*it++);
   }
 
-  return {p1, p2};
+  return {std::move(p1), std::move(p2)};
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::split(std::size_t pos) && -> std::pair<List, List> { // 前 pos 个节点留在 p1，其余节点原样接到 p2 上
+  List p1(std::move(*this)), p2(p1.alloc);
+  if (pos >= p1.siz)
+    return {std::move(p1), std::move(p2)};
+
+  ListNode<T> *first = p1.node->next, *last = p1.node->prev;
+  for (std::size_t i = 0; i < pos; ++i)
+    first = first->next;
+
+  first->prev->next = p1.node;
+  p1.node->prev = first->prev;
+  p2.node->next = first, first->prev = p2.node;
+  p2.node->prev = last, last->next = p2.node;
+  p2.siz = p1.siz - pos, p1.siz = pos;
+
+  return {std::move(p1), std::move(p2)};
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// List 获取节点分配器
+
+template<class T, class Alloc>
+inline auto List<T, Alloc>::get_allocator() const -> Alloc { return alloc; }
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 两个链表的拼接实现
 
-template<class T>
-auto List<T>::merge(const List<T> &other) -> void { // 合并链表
-  for (ListIterator<T> it = other.begin(); it != other.end(); ++it) {
-    push_back(*it);
+template<class T, class Alloc>
+auto List<T, Alloc>::merge(const List &other) -> void { // 合并链表，先记下个数，other 与自身相同时也只复制原有的元素
+  std::size_t count = other.siz;
+  ListIterator<T> it = other.begin();
+  for (std::size_t i = 0; i < count; ++i) {
+    push_back(*it++);
   }
 }
 
-template<class T>
-auto List<T>::operator+(const List<T> &other) -> List<T> { // 合并链表
-  List<T> result(*this);
+template<class T, class Alloc>
+auto List<T, Alloc>::operator+(const List &other) const & -> List { // 合并链表
+  List result(*this);
   result.merge(other);
   return result;
 }
 
-template<class T>
-auto List<T>::operator+=(const List<T> &other) -> List<T>& { // 合并链表
+template<class T, class Alloc>
+auto List<T, Alloc>::operator+(const List &other) && -> List { // 合并链表，直接复用左侧的节点
+  merge(other);
+  return std::move(*this);
+}
+
+template<class T, class Alloc>
+auto List<T, Alloc>::operator+=(const List &other) -> List& { // 合并链表
   this->merge(other);
   return *this;
 }
@@ -266,8 +543,8 @@ auto List<T>::operator+=(const List<T> &other) -> List<T>& { // 合并链表
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 比较是否相等实现
 
-template<class T>
-auto List<T>::operator==(const List<T> &other) const -> bool { // 判断相等
+template<class T, class Alloc>
+auto List<T, Alloc>::operator==(const List &other) const -> bool { // 判断相等
   ListIterator<T> it1 = begin(), it2 = other.begin(), it3 = end(), it4 = other.end();
   while (it1 != it3 && it2 != it4 && *it1 == *it2) {
     ++it1, ++it2;
@@ -275,14 +552,14 @@ auto List<T>::operator==(const List<T> &other) const -> bool { // 判断相等
   return it1 == it3 && it2 == it4;
 }
 
-template<class T>
-inline auto List<T>::operator!=(const List<T> &other) const -> bool { return !(*this == other); } // 比较不相等
+template<class T, class Alloc>
+inline auto List<T, Alloc>::operator!=(const List &other) const -> bool { return !(*this == other); } // 比较不相等
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // List 比较字典序大小
 
-template<class T>
-auto List<T>::operator<(const List<T> &other) const -> bool { // 按字典序比较
+template<class T, class Alloc>
+auto List<T, Alloc>::operator<(const List &other) const -> bool { // 按字典序比较
   ListIterator<T> it1, it2;
   for (it1 = begin(), it2 = other.begin(); it1 != end() && it2 != other.end(); ++it1, ++it2) {
     if (*it1 != *it2)
@@ -292,12 +569,12 @@ auto List<T>::operator<(const List<T> &other) const -> bool { // 按字典序比
 }
 
 // 比较字典序大小关系
-template<class T>
-inline auto List<T>::operator>=(const List<T> &other) const -> bool { return !(*this < other); }
-template<class T>
-inline auto List<T>::operator>(const List<T> &other) const -> bool { return other < *this; }
-template<class T>
-inline auto List<T>::operator<=(const List<T> &other) const -> bool { return other >= *this; }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::operator>=(const List &other) const -> bool { return !(*this < other); }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::operator>(const List &other) const -> bool { return other < *this; }
+template<class T, class Alloc>
+inline auto List<T, Alloc>::operator<=(const List &other) const -> bool { return other >= *this; }
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,57 @@
+#ifndef FDS_MONTGOMERY_
+#define FDS_MONTGOMERY_
+
+#include "big_integer.h"
+
+// 模任意奇数 n 的 Montgomery 乘法上下文
+// 对同一个模数预处理一次 n' = -n^{-1} mod 2^LIMB_LEN 和 R^2 mod n，之后的模乘和模幂都不需要除法
+// 其中 R = (2^LIMB_LEN)^s，s 为模数 n 所占的块数
+template <std::size_t M>
+class MontgomeryContext {
+ private: // 基本类型定义
+  typedef BigInteger<M> Integer;
+  typedef typename Integer::Limb Limb;
+  typedef typename Integer::Integral Integral;
+
+ private: // 常量
+  constexpr static std::size_t LIMB_LEN = Integer::LIMB_LEN;
+  constexpr static std::size_t LIMIT_NUMS = Integer::LIMIT_NUMS;
+
+ private: // 预处理得到的数据
+  Integer n;       // 模数
+  std::size_t s;   // 模数所占的块数
+  Limb n_prime;    // -n^{-1} mod 2^LIMB_LEN
+  Integer r_mod;   // R mod n，即 Montgomery 形式下的 1
+  Integer r2_mod;  // R^2 mod n，用于转换到 Montgomery 形式
+
+ public: // 构造函数
+  explicit MontgomeryContext(const Integer &modulus);
+
+ public: // 获取模数
+  auto modulus() const -> const Integer&;
+
+ public: // 普通形式下的模运算，输入可以是任意 [0, 2^M) 中的数
+  auto reduce(const Integer &a) const -> Integer; // a mod n
+  auto mulmod(const Integer &a, const Integer &b) const -> Integer; // a * b mod n
+  auto powmod(const Integer &a, const Integer &e) const -> Integer; // a ^ e mod n
+  auto powmod_ct(const Integer &a, const Integer &e) const -> Integer; // a ^ e mod n，耗时与 e 的取值无关，但与 pow_ct 一样会暴露 e 所占的块数
+  auto multi_powmod(const std::vector<Integer> &bases, const std::vector<Integer> &exps) const -> Integer; // prod bases[i] ^ exps[i] mod n
+
+ public: // Montgomery 形式的转换与运算，要求输入都已经在 [0, n) 中
+  auto to_montgomery(const Integer &a) const -> Integer; // a * R mod n，a 可以是任意 [0, 2^M) 中的数
+  auto from_montgomery(const Integer &a) const -> Integer; // a * R^{-1} mod n
+  auto mont_mul(const Integer &a, const Integer &b) const -> Integer; // a * b * R^{-1} mod n (CIOS)
+  auto mont_add(const Integer &a, const Integer &b) const -> Integer; // a + b mod n
+
+ private: // 辅助函数
+  static auto inverse_limb(Limb x) -> Limb; // 计算奇数 x 在模 2^LIMB_LEN 下的逆元
+  auto mont_mul_impl(const Limb *x, const Limb *y, Limb *out) const -> void; // s 块定长数组上的 CIOS，不含分支，out 可以与 x、y 相同
+  auto double_mod(const Integer &x) const -> Integer; // 2x mod n，不会溢出 2^M
+
+ private: // 批量运算直接使用预处理得到的数据
+  template <std::size_t N> friend class BigIntegerBatch;
+};
+
+#endif //FDS_MONTGOMERY_
+
+#include "montgomery_impl.h"
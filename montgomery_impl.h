@@ -0,0 +1,233 @@
+#ifndef FDS_MONTGOMERY_IMPL_
+#define FDS_MONTGOMERY_IMPL_
+
+#include "montgomery.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// MontgomeryContext 构造函数实现
+
+template<std::size_t M>
+MontgomeryContext<M>::MontgomeryContext(const Integer &modulus) : n(modulus), s(modulus.data.size()) {
+  if (n.data.empty() || (n.data.front() & 1) == 0)
+    throw std::logic_error("modulus of MontgomeryContext must be odd");
+
+  n_prime = (Limb)0 - inverse_limb(n.data.front());
+
+  // R mod n：从 1 开始倍增 LIMB_LEN * s 次，每次都保持在 [0, n) 中
+  r_mod = n == 1 ? Integer(0) : Integer(1);
+  for (std::size_t i = 0; i < LIMB_LEN * s; ++i)
+    r_mod = double_mod(r_mod);
+
+  // R^2 mod n：在 R mod n 的基础上再倍增 LIMB_LEN * s 次
+  r2_mod = r_mod;
+  for (std::size_t i = 0; i < LIMB_LEN * s; ++i)
+    r2_mod = double_mod(r2_mod);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 获取模数
+
+template<std::size_t M>
+auto MontgomeryContext<M>::modulus() const -> const Integer& { return n; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 普通形式下的模运算
+
+template<std::size_t M>
+auto MontgomeryContext<M>::reduce(const Integer &a) const -> Integer {
+  if (a < n)
+    return a;
+  return from_montgomery(to_montgomery(a));
+}
+
+template<std::size_t M>
+auto MontgomeryContext<M>::mulmod(const Integer &a, const Integer &b) const -> Integer {
+  // (a * R) * b * R^{-1} = a * b，只需要把其中一个数转换到 Montgomery 形式
+  return mont_mul(to_montgomery(a), reduce(b));
+}
+
+template<std::size_t M>
+auto MontgomeryContext<M>::powmod(const Integer &a, const Integer &e) const -> Integer {
+  Integer result = Integer::pow_sliding_window_impl(to_montgomery(a), e, r_mod,
+      [this](const Integer &x, const Integer &y) { return mont_mul(x, y); },
+      [this](const Integer &x) { return mont_mul(x, x); });
+  return from_montgomery(result);
+}
+
+template<std::size_t M>
+auto MontgomeryContext<M>::multi_powmod(const std::vector<Integer> &bases, const std::vector<Integer> &exps) const -> Integer {
+  std::vector<Integer> mont(bases.size());
+  for (std::size_t i = 0; i < bases.size(); ++i)
+    mont[i] = to_montgomery(bases[i]);
+  Integer result = Integer::multi_pow_impl(mont, exps, r_mod,
+      [this](const Integer &x, const Integer &y) { return mont_mul(x, y); },
+      [this](const Integer &x) { return mont_mul(x, x); });
+  return from_montgomery(result);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 常数时间的模幂
+// 与 BigInteger::pow_ct 相同的固定窗口方法，乘法都在 s 块的定长数组上用 mont_mul_impl 完成
+// 指数一律按 LIMIT_NUMS * LIMB_LEN 位处理，表项通过扫描整张表取出
+
+template<std::size_t M>
+auto MontgomeryContext<M>::powmod_ct(const Integer &a, const Integer &e) const -> Integer {
+  const std::size_t W = Integer::POW_CT_WINDOW_LENGTH, SIZE = Integer::POW_CT_TABLE_SIZE;
+  std::vector<Limb> table(SIZE * s, 0), result(s, 0), entry(s), exp(LIMIT_NUMS, 0);
+
+  // 预处理 Montgomery 形式下的 a^0, a^1, ..., a^{2^w - 1}
+  Integer base = to_montgomery(a);
+  std::copy(r_mod.data.begin(), r_mod.data.end(), table.begin());
+  std::copy(base.data.begin(), base.data.end(), table.begin() + s);
+  for (std::size_t i = 2; i < SIZE; ++i)
+    mont_mul_impl(&table[(i - 1) * s], &table[s], &table[i * s]);
+
+  std::copy(e.data.begin(), e.data.end(), exp.begin());
+  std::copy(table.begin(), table.begin() + s, result.begin());
+
+  for (std::size_t k = LIMIT_NUMS; k > 0; --k) {
+    for (std::size_t w = LIMB_LEN / W; w > 0; --w) {
+      for (std::size_t i = 0; i < W; ++i)
+        mont_mul_impl(result.data(), result.data(), result.data());
+      Integer::ct_lookup(entry.data(), table.data(), SIZE, s, (std::size_t)(exp[k - 1] >> (W * (w - 1))) & (SIZE - 1));
+      mont_mul_impl(result.data(), entry.data(), result.data());
+    }
+  }
+
+  Integer r;
+  r.data.resize(s, 0);
+  std::copy(result.begin(), result.end(), r.data.begin());
+  r.fix();
+  return from_montgomery(r);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 转换到 Montgomery 形式
+// 把 a 按 s 块一段拆成 c_k R^k + ... + c_1 R + c_0，再用秦九韶算法在 Montgomery 形式下求值
+
+template<std::size_t M>
+auto MontgomeryContext<M>::to_montgomery(const Integer &a) const -> Integer {
+  Integer result;
+  std::size_t chunks = (a.data.size() + s - 1) / s;
+
+  for (std::size_t k = chunks; k > 0; --k) {
+    Integer c;
+    for (std::size_t i = (k - 1) * s; i < k * s && i < a.data.size(); ++i)
+      c.data.push_back(a.data[i]);
+    c.fix();
+
+    // c < R 且 R^2 mod n < n，所以 c * (R^2 mod n) < nR，满足 CIOS 的前提
+    if (k == chunks)
+      result = mont_mul(c, r2_mod);
+    else
+      result = mont_add(mont_mul(result, r2_mod), mont_mul(c, r2_mod));
+  }
+
+  return result;
+}
+
+template<std::size_t M>
+auto MontgomeryContext<M>::from_montgomery(const Integer &a) const -> Integer {
+  return mont_mul(a, Integer(1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// Montgomery 乘法
+
+template<std::size_t M>
+auto MontgomeryContext<M>::mont_mul(const Integer &a, const Integer &b) const -> Integer {
+  assert(a.data.size() <= s && b.data.size() <= s);
+
+  Limb x[LIMIT_NUMS], y[LIMIT_NUMS];
+
+  // 补齐到 s 块，省去循环中的边界判断
+  std::fill(std::copy(a.data.begin(), a.data.end(), x), x + s, 0);
+  std::fill(std::copy(b.data.begin(), b.data.end(), y), y + s, 0);
+  mont_mul_impl(x, y, x);
+
+  Integer result;
+  result.data.resize(s, 0);
+  std::copy(x, x + s, result.data.begin());
+  result.fix();
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 mont_mul_impl
+// 采用 CIOS（Coarsely Integrated Operand Scanning）方法
+// 每一轮先累加 a * b[i]，再加上 m * n 使最低块为 0 并整体右移一块，所需空间只有 s + 2 块
+
+template<std::size_t M>
+auto MontgomeryContext<M>::mont_mul_impl(const Limb *x, const Limb *y, Limb *out) const -> void {
+  Limb t[LIMIT_NUMS + 2], d[LIMIT_NUMS];
+  const Limb *p = n.data.data();
+  std::fill(t, t + s + 2, 0);
+
+  for (std::size_t i = 0; i < s; ++i) {
+    Integral cur;
+    Limb carry = 0;
+
+    // t += a * b[i]
+    for (std::size_t j = 0; j < s; ++j) {
+      cur = (Integral)x[j] * y[i] + t[j] + carry;
+      t[j] = (Limb)cur;
+      carry = (Limb)(cur >> LIMB_LEN);
+    }
+    cur = (Integral)t[s] + carry;
+    t[s] = (Limb)cur;
+    t[s + 1] = (Limb)(cur >> LIMB_LEN);
+
+    // t = (t + m * n) / 2^LIMB_LEN，其中 m 使得最低块恰好为 0
+    Limb m = t[0] * n_prime;
+    cur = (Integral)m * p[0] + t[0];
+    carry = (Limb)(cur >> LIMB_LEN);
+    for (std::size_t j = 1; j < s; ++j) {
+      cur = (Integral)m * p[j] + t[j] + carry;
+      t[j - 1] = (Limb)cur;
+      carry = (Limb)(cur >> LIMB_LEN);
+    }
+    cur = (Integral)t[s] + carry;
+    t[s - 1] = (Limb)cur;
+    t[s] = t[s + 1] + (Limb)(cur >> LIMB_LEN);
+  }
+
+  // 此时 t < 2n，最多需要减去一次 n：总是计算 t - n，再按是否 t < n 选择结果，避免分支
+  // t[s] 为 1 时 t 一定不小于 n，否则 t - n 产生借位当且仅当 t < n
+  Limb borrow = Integer::ct_sub(d, t, p, s);
+  Integer::ct_select(out, t, d, s, borrow & ~t[s] & 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 模加法，两个输入都在 [0, n) 中
+
+template<std::size_t M>
+auto MontgomeryContext<M>::mont_add(const Integer &a, const Integer &b) const -> Integer {
+  // 避免 a + b 超出 2^M，先比较 a 和 n - b
+  Integer rest = n - b;
+  return a >= rest ? a - rest : a + b;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 inverse_limb
+// 牛顿迭代求逆元，每一轮精度翻倍（奇数 x 满足 x * x = 1 mod 8，初始即有 3 位精度）
+
+template<std::size_t M>
+auto MontgomeryContext<M>::inverse_limb(Limb x) -> Limb {
+  Limb y = x;
+  for (std::size_t bits = 3; bits < LIMB_LEN; bits *= 2)
+    y *= (Limb)2 - x * y;
+  return y;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 double_mod
+// 计算 2x mod n，同样通过比较 x 和 n - x 来避免溢出
+
+template<std::size_t M>
+auto MontgomeryContext<M>::double_mod(const Integer &x) const -> Integer {
+  return mont_add(x, x);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_MONTGOMERY_IMPL_
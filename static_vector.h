@@ -0,0 +1,108 @@
+#ifndef FDS_STATIC_VECTOR_
+#define FDS_STATIC_VECTOR_
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// 容量不超过 STATIC_VECTOR_INLINE_BYTES 字节时元素内嵌在对象中，否则放在堆上
+// 例如 M = 10^7 时一个大整数有 1.25 MB，内嵌的话几个临时对象就会耗尽默认 8 MB 的栈
+constexpr std::size_t STATIC_VECTOR_INLINE_BYTES = 65536;
+
+// 元素缓冲区：内嵌版本直接是数组，堆上版本在第一次写入时才分配，移动时只转移指针
+template <class T, std::size_t N, bool Heap = (N * sizeof(T) > STATIC_VECTOR_INLINE_BYTES)>
+struct StaticVectorBuffer {
+  T elems[N];
+
+  auto get() -> T* { return elems; }
+  auto get() const -> const T* { return elems; }
+  auto acquire() -> T* { return elems; }
+  static constexpr auto movable() -> bool { return false; }
+  auto swap(StaticVectorBuffer &) noexcept -> void {}
+};
+
+template <class T, std::size_t N>
+struct StaticVectorBuffer<T, N, true> {
+  std::unique_ptr<T[]> elems;
+
+  auto get() -> T* { return elems.get(); }
+  auto get() const -> const T* { return elems.get(); }
+  auto acquire() -> T* { // 元素不做初始化，没有写到的页不会真正占用内存
+    if (!elems)
+      elems.reset(new T[N]);
+    return elems.get();
+  }
+  static constexpr auto movable() -> bool { return true; }
+  auto swap(StaticVectorBuffer &other) noexcept -> void { elems.swap(other.elems); }
+};
+
+// 定长连续数组：容量 N 在编译期确定，较小时元素直接内嵌在对象中，不进行任何堆分配
+// 接口与 List<T> 保持一致，便于大整数的各个辅助函数直接替换底层存储
+template <class T, std::size_t N>
+class StaticVector {
+  static_assert(N != 0, "N == 0 is not allowed for template class StaticVector<T, N>");
+
+ public: // 元素存储和大小
+  StaticVectorBuffer<T, N> buf;
+  std::size_t siz;
+
+ public: // 构造与析构函数
+  StaticVector();
+  explicit StaticVector(std::size_t count, const T& value = T());
+  StaticVector(const StaticVector &other);
+  StaticVector(StaticVector &&other) noexcept;
+  ~StaticVector() = default;
+  auto reconstruct(const StaticVector &other) -> void;
+  auto reconstruct(std::size_t count, const T& value) -> void;
+
+ public: // 拷贝与交换
+  auto operator=(const StaticVector &other) -> StaticVector&;
+  auto operator=(StaticVector &&other) noexcept -> StaticVector&;
+  auto swap(StaticVector &other) -> void;
+  auto swap(StaticVector &&other) -> void;
+
+ public: // 随机访问
+  auto operator[](std::size_t pos) -> T&;
+  auto operator[](std::size_t pos) const -> const T&;
+  auto data() -> T*;
+  auto data() const -> const T*;
+
+ public: // 返回头尾元素
+  auto front() -> T&;
+  auto front() const -> const T&;
+  auto back() -> T&;
+  auto back() const -> const T&;
+
+ public: // 获取头尾迭代器
+  auto begin() -> T*;
+  auto begin() const -> const T*;
+  auto end() -> T*;
+  auto end() const -> const T*;
+
+ public: // 判空与获取容量
+  auto empty() const -> bool;
+  auto size() const -> std::size_t;
+  static constexpr auto capacity() -> std::size_t { return N; }
+
+ public: // 清空与调整大小
+  auto clear() -> void;
+  auto resize(std::size_t count, const T& value = T()) -> void;
+
+ public: // 头尾增删元素
+  auto push_back(const T& val) -> void;
+  auto push_front(const T& val) -> void;
+  auto pop_back() -> void;
+  auto pop_front() -> void;
+
+ public: // 数组分裂为 [first, pos), [pos, last)
+  auto split(std::size_t pos) const -> std::pair<StaticVector, StaticVector>;
+
+ public: // 比较是否相等
+  auto operator==(const StaticVector &other) const -> bool;
+  auto operator!=(const StaticVector &other) const -> bool;
+};
+
+#endif //FDS_STATIC_VECTOR_
+
+#include "static_vector_impl.h"
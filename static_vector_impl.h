@@ -0,0 +1,198 @@
+#ifndef FDS_STATIC_VECTOR_IMPL_
+#define FDS_STATIC_VECTOR_IMPL_
+
+#include <algorithm>
+#include <cassert>
+
+#include "static_vector.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 构造函数实现
+
+template<class T, std::size_t N>
+inline StaticVector<T, N>::StaticVector() : siz() {} // 构造函数，元素不做初始化
+
+template<class T, std::size_t N>
+StaticVector<T, N>::StaticVector(std::size_t count, const T &value) : siz() { // 构造函数
+  resize(count, value);
+}
+
+template<class T, std::size_t N>
+StaticVector<T, N>::StaticVector(const StaticVector &other) : siz(other.siz) { // 复制构造函数，只复制有效部分
+  if (siz != 0)
+    std::copy(other.buf.get(), other.buf.get() + siz, buf.acquire());
+}
+
+template<class T, std::size_t N>
+StaticVector<T, N>::StaticVector(StaticVector &&other) noexcept : siz(other.siz) { // 移动构造函数，堆上的缓冲区直接接管
+  if (buf.movable())
+    buf.swap(other.buf), other.siz = 0;
+  else
+    std::copy(other.buf.get(), other.buf.get() + siz, buf.get());
+}
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::reconstruct(const StaticVector &other) -> void { *this = other; }
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::reconstruct(std::size_t count, const T& value) -> void {
+  siz = 0;
+  resize(count, value);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 拷贝与交换
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::operator=(const StaticVector &other) -> StaticVector& {
+  if (this != &other) {
+    if (other.siz != 0)
+      std::copy(other.buf.get(), other.buf.get() + other.siz, buf.acquire());
+    siz = other.siz;
+  }
+  return *this;
+}
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::operator=(StaticVector &&other) noexcept -> StaticVector& {
+  if (this != &other) {
+    if (buf.movable()) {
+      buf.swap(other.buf);
+      std::swap(siz, other.siz);
+    } else {
+      std::copy(other.buf.get(), other.buf.get() + other.siz, buf.get());
+      siz = other.siz;
+    }
+  }
+  return *this;
+}
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::swap(StaticVector &other) -> void { // 堆上的缓冲区交换指针，内嵌的只交换两者中有效的部分
+  if (buf.movable())
+    buf.swap(other.buf);
+  else
+    std::swap_ranges(buf.get(), buf.get() + std::max(siz, other.siz), other.buf.get());
+  std::swap(siz, other.siz);
+}
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::swap(StaticVector &&other) -> void { swap(other); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 随机访问实现
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::operator[](std::size_t pos) -> T& { return buf.get()[pos]; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::operator[](std::size_t pos) const -> const T& { return buf.get()[pos]; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::data() -> T* { return buf.get(); }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::data() const -> const T* { return buf.get(); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 取头尾元素实现
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::front() -> T& { return buf.get()[0]; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::front() const -> const T& { return buf.get()[0]; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::back() -> T& { return buf.get()[siz - 1]; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::back() const -> const T& { return buf.get()[siz - 1]; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 取头尾迭代器实现
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::begin() -> T* { return buf.get(); }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::begin() const -> const T* { return buf.get(); }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::end() -> T* { return buf.get() + siz; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::end() const -> const T* { return buf.get() + siz; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 容量相关，判空与获取大小
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::empty() const -> bool { return siz == 0; }
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::size() const -> std::size_t { return siz; }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 清空与调整大小
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::clear() -> void { siz = 0; }
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::resize(std::size_t count, const T &value) -> void { // 新增的部分用 value 填充
+  assert(count <= N);
+  if (count > siz) {
+    T *elems = buf.acquire();
+    std::fill(elems + siz, elems + count, value);
+  }
+  siz = count;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 在头尾插入删除实现
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::push_back(const T &val) -> void {
+  assert(siz < N);
+  buf.acquire()[siz++] = val;
+}
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::push_front(const T &val) -> void { // 需要整体后移，尽量避免频繁调用
+  assert(siz < N);
+  T *elems = buf.acquire();
+  std::copy_backward(elems, elems + siz, elems + siz + 1);
+  elems[0] = val;
+  ++siz;
+}
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::pop_back() -> void { --siz; }
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::pop_front() -> void {
+  std::copy(buf.get() + 1, buf.get() + siz, buf.get());
+  --siz;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 分裂实现
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::split(std::size_t pos) const -> std::pair<StaticVector, StaticVector> {
+  std::pair<StaticVector, StaticVector> result;
+  pos = std::min(pos, siz);
+
+  if (pos != 0)
+    std::copy(buf.get(), buf.get() + pos, result.first.buf.acquire());
+  result.first.siz = pos;
+  if (siz != pos)
+    std::copy(buf.get() + pos, buf.get() + siz, result.second.buf.acquire());
+  result.second.siz = siz - pos;
+
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// StaticVector 比较是否相等实现
+
+template<class T, std::size_t N>
+auto StaticVector<T, N>::operator==(const StaticVector &other) const -> bool {
+  return siz == other.siz && std::equal(buf.get(), buf.get() + siz, other.buf.get());
+}
+
+template<class T, std::size_t N>
+inline auto StaticVector<T, N>::operator!=(const StaticVector &other) const -> bool { return !(*this == other); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_STATIC_VECTOR_IMPL_
@@ -1,8 +1,43 @@
 #include "big_integer.h"
+#include "montgomery.h"
+#include "barrett.h"
+#include "big_integer_batch.h"
+#include "fixed_base_pow.h"
+#include "big_integer_expr.h"
+#include "big_integer_literal.h"
+#include "thread_pool.h"
+#define FDS_LIST_ALLOC_STATS // 统计链表节点的分配情况，检查没有泄漏
+#include "list.h"
+
+#include <thread>
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
+// 用于直接调用 BigInteger 内部的乘法算法，与朴素乘法对照
+struct BigIntegerAccess {
+  template <std::size_t M>
+  static auto mul_base(const BigInteger<M> &a, const BigInteger<M> &b) -> BigInteger<M> { return BigInteger<M>::mul_base(a, b); }
+  template <std::size_t M>
+  static auto mul_toom3(const BigInteger<M> &a, const BigInteger<M> &b) -> BigInteger<M> { return BigInteger<M>::mul_toom3(a, b); }
+  template <std::size_t M>
+  static auto mul_toom4(const BigInteger<M> &a, const BigInteger<M> &b) -> BigInteger<M> { return BigInteger<M>::mul_toom4(a, b); }
+  template <std::size_t M>
+  static auto mul_ntt(const BigInteger<M> &a, const BigInteger<M> &b) -> BigInteger<M> { return BigInteger<M>::mul_ntt(a, b); }
+  template <std::size_t M>
+  static auto multi_pow_straus(const std::vector<BigInteger<M>> &a, const std::vector<BigInteger<M>> &e, std::size_t w) -> BigInteger<M> {
+    return BigInteger<M>::multi_pow_straus(a, e, BigInteger<M>(1),
+        [](const BigInteger<M> &x, const BigInteger<M> &y) { return x * y; },
+        [](const BigInteger<M> &x) { return BigInteger<M>::sqr(x); }, w);
+  }
+  template <std::size_t M>
+  static auto multi_pow_pippenger(const std::vector<BigInteger<M>> &a, const std::vector<BigInteger<M>> &e, std::size_t w) -> BigInteger<M> {
+    return BigInteger<M>::multi_pow_pippenger(a, e, BigInteger<M>(1),
+        [](const BigInteger<M> &x, const BigInteger<M> &y) { return x * y; },
+        [](const BigInteger<M> &x) { return BigInteger<M>::sqr(x); }, w);
+  }
+};
+
 TEST_CASE("BigInteger", "[BigInteger]") {
   SECTION("Constructor & Destructor") {
     BigInteger<2048> $1;
@@ -86,6 +121,120 @@ TEST_CASE("BigInteger", "[BigInteger]") {
     REQUIRE($1 * $2 == "26179958962246498097200768895325351799824027786204536189425822288703346955364538160973800390340798052542405282262762537224651294861005146752446759599147228447272661126866188145937944862992508110931706170030328725022105882479687273788850542385386067518441580576851264845970830154764090845541725123958209636358479648446811781974652913666423185519692453501894756859711756942643572970671617299769276219690317053393661466134902344572304415715715312782500907545714954180360215442125344370845561923424125055493072996145956163338615373786009288803172634844240501784878952388920132506465935756431625318876481659291831036527847");
   }
 
+  SECTION("Operator Mul Toom-Cook") {
+    typedef BigIntegerAccess A;
+
+    // 不同长度的操作数，包括两边长度不等、结果被 2^M 截断以及插值中出现负数的情况
+    BigInteger<16384> $1(1), $2(7);
+    for (std::size_t i = 0; i < 256; ++i) {
+      $1 = $1 * 0x9e3779b97f4a7c15ULL + i, $2 = $2 * 0xc2b2ae3d27d4eb4fULL + (i ^ 0x55);
+      if (i % 37 == 0 || i == 255) {
+        BigInteger<16384> $3 = $2 >> (i * 13 % 97);
+        REQUIRE(A::mul_toom3($1, $3) == A::mul_base($1, $3));
+        REQUIRE(A::mul_toom4($1, $3) == A::mul_base($1, $3));
+      }
+    }
+
+    BigInteger<16384> $4 = BigInteger<16384>(0) - 1, $5 = $4 << 8000;
+    REQUIRE(A::mul_toom3($4, $4) == 1);
+    REQUIRE(A::mul_toom4($4, $4) == 1);
+    REQUIRE(A::mul_toom3($4, $5) == A::mul_base($4, $5));
+    REQUIRE(A::mul_toom4($5, $1) == A::mul_base($5, $1));
+
+    // 经过分派的完整乘积
+    BigInteger<65536> $6(3), $7(5);
+    for (std::size_t i = 0; i < 500; ++i)
+      $6 = $6 * 0xfedcba9876543211ULL + i, $7 = $7 * 0x123456789abcdefULL + i;
+    REQUIRE($6 * $7 == A::mul_base($6, $7));
+
+    // M 较大时各段和求值点放进一半宽度的 Half 中计算，乘积会被截断时仍在 M 位中计算
+    BigInteger<131072> $8(3), $9(5);
+    for (std::size_t i = 0; i < 1000; ++i)
+      $8 = $8 * 0xfedcba9876543211ULL + i, $9 = $9 * 0x123456789abcdefULL + (i ^ 0x33);
+    REQUIRE(A::mul_toom3($8, $9) == A::mul_base($8, $9));
+    REQUIRE(A::mul_toom4($8, $9) == A::mul_base($8, $9));
+    REQUIRE(A::mul_toom3($8 << 60000, $9 << 60000) == A::mul_base($8 << 60000, $9 << 60000));
+    REQUIRE(A::mul_toom4($8 << 60000, $9 << 60000) == A::mul_base($8 << 60000, $9 << 60000));
+  }
+
+  SECTION("Operator Mul NTT") {
+    typedef BigIntegerAccess A;
+
+    // 小规模直接调用，覆盖 0、单个系数、两边长度不等以及结果被 2^M 截断的情况
+    BigInteger<16384> $1(1), $2(7);
+    REQUIRE(A::mul_ntt($1, BigInteger<16384>(0)) == 0);
+    REQUIRE(A::mul_ntt($2, $2) == 49);
+    for (std::size_t i = 0; i < 256; ++i) {
+      $1 = $1 * 0x9e3779b97f4a7c15ULL + i, $2 = $2 * 0xc2b2ae3d27d4eb4fULL + (i ^ 0x55);
+      if (i % 37 == 0 || i == 255) {
+        BigInteger<16384> $3 = $2 >> (i * 13 % 97);
+        REQUIRE(A::mul_ntt($1, $3) == A::mul_base($1, $3));
+        REQUIRE(A::mul_ntt($1, $1) == A::mul_base($1, $1));
+      }
+    }
+    BigInteger<16384> $4 = BigInteger<16384>(0) - 1;
+    REQUIRE(A::mul_ntt($4, $4) == 1);
+
+    // 经过分派的大规模乘法与平方，系数全为 2^32 - 1 时卷积的每一项最大
+    BigInteger<524288> $5 = (BigInteger<524288>(1) << 262144) - 1, $6(3);
+    for (std::size_t i = 0; i < 4096; ++i)
+      $6 = $6 * 0xfedcba9876543211ULL + i;
+    REQUIRE($5 * $6 == A::mul_base($5, $6));
+    REQUIRE($5 * $5 == A::mul_base($5, $5));
+    REQUIRE(BigInteger<524288>::sqr($6) == A::mul_base($6, $6));
+    REQUIRE(($6 << 262144) * $6 == A::mul_base($6 << 262144, $6));
+  }
+
+  SECTION("Square") {
+    // 与一般乘法对照，覆盖朴素平方、Karatsuba 平方以及结果被 2^M 截断的情况
+    BigInteger<8192> $1(1);
+    for (std::size_t i = 0; i < 8192; i += 61) {
+      $1 = $1 * 0x9e3779b97f4a7c15ULL + i;
+      REQUIRE(BigInteger<8192>::sqr($1) == $1 * BigInteger<8192>($1));
+    }
+
+    BigInteger<2048> $2 = BigInteger<2048>(0) - 1;
+    REQUIRE(BigInteger<2048>::sqr($2) == 1);
+    REQUIRE($2 * BigInteger<2048>($2) == 1);
+    REQUIRE(BigInteger<2048>::sqr(BigInteger<2048>(0)) == 0);
+
+    // M 较大时子问题放进一半宽度的 Half 中，覆盖整体交给 Half、只有两半放进 Half 以及结果被截断的情况
+    typedef BigIntegerAccess A;
+    BigInteger<131072> $3(3), $4 = (BigInteger<131072>(1) << 65536) - 1;
+    for (std::size_t i = 0; i < 1400; ++i) {
+      $3 = $3 * 0xfedcba9876543211ULL + i;
+      if (i % 350 == 349)
+        REQUIRE(BigInteger<131072>::sqr($3) == A::mul_base($3, $3));
+    }
+    REQUIRE(BigInteger<131072>::sqr($4) == A::mul_base($4, $4));
+    REQUIRE(BigInteger<131072>::sqr($4 << 1000) == A::mul_base($4 << 1000, $4 << 1000));
+  }
+
+  SECTION("Truncated Multiplication") {
+    // 满位宽的乘积只保留低 M 位：(2^M - 1) * (2^M - 1) = 1，(2^M - x) * y = -xy (mod 2^M)
+    BigInteger<16384> $1 = BigInteger<16384>(0) - 1, $2 = $1;
+    REQUIRE($1 * $2 == 1);
+    REQUIRE(BigInteger<16384>::sqr($1) == 1);
+
+    BigInteger<16384> $3(1), $4(3);
+    for (std::size_t i = 0; i < 300; ++i)
+      $3 = $3 * 0xfedcba9876543211ULL + i, $4 = $4 * 0x123456789abcdefULL + i;
+    REQUIRE((BigInteger<16384>(0) - $3) * $4 == BigInteger<16384>(0) - $3 * $4);
+    REQUIRE(($3 << 8192) * ($4 << 8192) == 0);
+    REQUIRE(($3 << 5000) * $4 == ($3 * $4) << 5000);
+    REQUIRE(BigInteger<16384>::sqr($3 << 4000) == BigInteger<16384>::sqr($3) << 8000);
+
+    // 大 M 下满位宽乘以较短的数，中间结果按子乘积的大小存放，不会在默认大小的栈上溢出
+    typedef BigIntegerAccess A;
+    typedef BigInteger<524288> L;
+    L $5 = ~L(0), $6 = (L(1) << 65535) - 3, $7 = $3.widen<524288>() << 300000;
+    REQUIRE($5 * $6 == L(0) - $6);
+    REQUIRE($6 * $5 == L(0) - $6);
+    $7 += $7 << 150000;
+    REQUIRE(($5 - $7) * $6 == A::mul_base($5 - $7, $6));
+    REQUIRE(L::sqr($5 - $7) == A::mul_base($5 - $7, $5 - $7));
+  }
+
   SECTION("Operator Div Sub") {
     BigInteger<2048> $1("57219834798127598127983412789571982738912789572897389127839412957");
     BigInteger<2048> $2("2333333333333333333333333333333333333");
@@ -120,6 +269,31 @@ TEST_CASE("BigInteger", "[BigInteger]") {
     REQUIRE($1 / $4 == "5100575226264137637055354122532104233227257212153152776748172316767527181479098983766790582564850732396979678738286343757606458854270820343313460713982671484022573073284340588795114295264033144248824891789299633517298302727411838982834859154856486638188558784975539571545809478447383656601636019333057808812320408675459265473332510460197972112915301792457659239884205157566629174515391166231321788199873258");
   }
 
+  SECTION("Operator Mod & Divmod") {
+    BigInteger<2048> $1("57219834798127598127983412789571982738912789572897389127839412957");
+    BigInteger<2048> $2("2333333333333333333333333333333333333");
+
+    REQUIRE($1 % $2 == "1238649413753718353582284098503710022");
+
+    auto $3 = BigInteger<2048>::divmod($1, $2);
+    REQUIRE($3.first == "24522786342054684911992891195");
+    REQUIRE($3.second == "1238649413753718353582284098503710022");
+    REQUIRE($3.first * $2 + $3.second == $1);
+
+    BigInteger<4096> $4("2503920051251275111885028959335509948958343902861378456932112059725668578401643241764117887151528946013038685382841623063429924836563448983554367794606010532143073372870384393955838234793348568205781081390783933502228692898595747678367238101283195539244202963440256373108961664542117510741430327178151510026190800655538419749774867223706881930523045459274825683526763536480927907610825769993884165206328413114934776565342311110444439780293315154758347899949753439376980501074667758373439259498317103860769255243888863260296594119344291451120178485234065593136618239967162088962426645719090222428756093453969904919741");
+    REQUIRE($4 % 1000000007ULL == 877495960ULL);
+    REQUIRE($4 % "18446744073709551629" == "13843717063611943188");
+    REQUIRE($2 % $1 == $2);
+
+    bool flag = false;
+    try {
+      auto $ = $1 % 0;
+    } catch (std::exception &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
   SECTION("Operator Pow") {
     BigInteger<2048> $1("6137047109064509203514107793344600160620074883510947842704523138821308183503352732223401021182115411146312678659135482269468264289485774342641392787301054673358216240434807945812252887397143995864351468353738843254686336162932482372987551953090102952140065275185040196916745736776974963065827275165720749163434684942856560446032061120141383975163722533431565198366048716687453222036843014380982373173860063332282137583559512785293935436586333121902790067518333050866910242585475838879595178302806267976605546434700534596430623482343709835042890322148935550664649746513097098179382722173326829317074194319228559702809");
     REQUIRE(($1 ^ $1) == "30277429100831583740641387982865525050824493692368117709050251714326926367544510489668751050789935377920268462039041356148714214929502156411729323827402181006162013107140813427603575134290786722402929967294743578720059525757113822852086886591571921123052341966183072681763348899456066948052452054741344174030300742548491074496175879237685834051642898397648219710872388092485427628827205009855084339929297314175295499613386076937683726645695520610439364567065214113360640627394604028807224458156777478878722071624011169717295833493432948942152724736141790313733089660780962304515088925239617887852268303601597416921177");
@@ -128,6 +302,193 @@ TEST_CASE("BigInteger", "[BigInteger]") {
     REQUIRE(($2 ^ $2) == "13615198422178218899340214381259384244727185755950535477863074841690552190867352323284221785102081519979226722587845445647015793599684435544237843217049286086667024929576674413842599697979901114466605541448081188583423636489658400253623254602927081021884454598031463390138347363597232580077851990181217865832123107207980113995698528503807604972890183240328367496266358760768824819524243381854244537229506776745799899113939750591369590209237530974398625275342274385913740790265026583302717957875483324393873702966375166291210261562082396522319838384912376613327179810445235522311782017499086805260437270581491288277999");
   }
 
+  SECTION("Constant-Time Pow") {
+    BigInteger<2048> $1("6137047109064509203514107793344600160620074883510947842704523138821308183503352732223401021182115411146312678659135482269468264289485774342641392787301054673358216240434807945812252887397143995864351468353738843254686336162932482372987551953090102952140065275185040196916745736776974963065827275165720749163434684942856560446032061120141383975163722533431565198366048716687453222036843014380982373173860063332282137583559512785293935436586333121902790067518333050866910242585475838879595178302806267976605546434700534596430623482343709835042890322148935550664649746513097098179382722173326829317074194319228559702809");
+    REQUIRE(BigInteger<2048>::pow_ct($1, $1) == ($1 ^ $1));
+    REQUIRE(BigInteger<2048>::pow_ct($1, BigInteger<2048>(0)) == 1);
+    REQUIRE(BigInteger<2048>::pow_ct($1, BigInteger<2048>(1)) == $1);
+    REQUIRE(BigInteger<2048>::pow_ct(BigInteger<2048>(0), BigInteger<2048>(0)) == 1);
+
+    // M 不是块长的整数倍时，结果同样要截断到 M 位
+    BigInteger<100> $2("1267650600228229401496703205375"), $3("98765432109876543210");
+    REQUIRE(BigInteger<100>::pow_ct($2, $3) == ($2 ^ $3));
+    REQUIRE(BigInteger<100>::pow_ct($3, $2) == ($3 ^ $2));
+  }
+
+  SECTION("Rvalue Operators") {
+    // 左侧为临时对象时在它的存储上原地计算，结果与左值版本一致，右侧与左侧相同时也正确
+    BigInteger<1024> $1(0x9e3779b97f4a7c15ULL), $2(0xfedcba9876543211ULL);
+    for (std::size_t i = 0; i < 12; ++i)
+      $1 = $1 * $2 + i;
+    $2 = $1 >> 300;
+
+    REQUIRE(BigInteger<1024>($1) + $2 == $1 + $2);
+    REQUIRE(BigInteger<1024>($2) - $1 == $2 - $1);
+    REQUIRE(BigInteger<1024>($1) * $2 == $1 * $2);
+    REQUIRE((BigInteger<1024>($1) & $2) == ($1 & $2));
+    REQUIRE((BigInteger<1024>($1) | $2) == ($1 | $2));
+    REQUIRE(BigInteger<1024>($1) << 77 == $1 << 77);
+    REQUIRE(BigInteger<1024>($1) >> 77 == $1 >> 77);
+    REQUIRE($1 * $2 + $1 - $2 == BigInteger<1024>::mul_wide($1, $2).low_half() + $1 - $2);
+
+    BigInteger<1024> $3 = $1;
+    REQUIRE(std::move($3) * $3 == $1 * $1);
+    $3 = $1;
+    REQUIRE(std::move($3) - $3 == 0);
+  }
+
+  SECTION("Widen & Narrow") {
+    BigInteger<1024> $1(0x9e3779b97f4a7c15ULL), $2 = ~BigInteger<1024>(0);
+    for (std::size_t i = 0; i < 16; ++i)
+      $1 = $1 * 0xfedcba9876543211ULL + i;
+
+    // 完整乘积的高低两半分别与移位和截断的结果一致
+    auto $3 = BigInteger<1024>::mul_wide($1, $2);
+    REQUIRE($3.low_half() == $1 * $2);
+    REQUIRE($3.high_half() == ($3 >> 1024).narrow<1024>());
+    REQUIRE($3 == $1.widen<2048>() * $2.widen<2048>());
+    REQUIRE(BigInteger<1024>::mul_wide($2, $2) == ~BigInteger<2048>(0) - (BigInteger<2048>(1) << 1025) + 2); // (2^1024 - 1)^2
+    REQUIRE(BigInteger<1024>::mul_wide($1, BigInteger<1024>(0)) == 0);
+
+    // 一半不落在块边界上时按位移动，窄化时截断到 N 位
+    BigInteger<200> $4("1234567890123456789012345678901234567890123456789012345678");
+    REQUIRE($4.low_half() == BigInteger<100>(($4 & ((BigInteger<200>(1) << 100) - 1)).dec()));
+    REQUIRE($4.high_half() == BigInteger<100>(($4 >> 100).dec()));
+    REQUIRE($4.narrow<70>().widen<200>() == ($4 & ((BigInteger<200>(1) << 70) - 1)));
+    REQUIRE($4.widen<4096>().narrow<200>() == $4);
+    REQUIRE(BigInteger<128>(5).high_half() == 0);
+  }
+
+  SECTION("Multi Pow") {
+    typedef BigIntegerAccess A;
+
+    // 逐项求幂再相乘作为对照，包含指数为 0 和长短不一的项
+    std::vector<BigInteger<1024>> $1, $2;
+    BigInteger<1024> x(0x9e3779b97f4a7c15ULL), expected(1);
+    for (std::size_t i = 0; i < 40; ++i) {
+      x = x * 0xfedcba9876543211ULL + i;
+      BigInteger<1024> e = i % 7 == 3 ? BigInteger<1024>(0) : x >> (i * 23);
+      $1.push_back(x | BigInteger<1024>(1)), $2.push_back(e);
+      expected *= $1.back() ^ e;
+    }
+
+    REQUIRE(BigInteger<1024>::multi_pow($1, $2) == expected);
+    for (std::size_t w : {1, 3, 5, 8})
+      REQUIRE(A::multi_pow_straus($1, $2, w) == expected);
+    for (std::size_t w : {1, 4, 7, 13, 16})
+      REQUIRE(A::multi_pow_pippenger($1, $2, w) == expected);
+
+    REQUIRE(BigInteger<1024>::multi_pow({$1[0]}, {$2[0]}) == ($1[0] ^ $2[0]));
+    REQUIRE(BigInteger<1024>::multi_pow({}, {}) == 1);
+    REQUIRE(BigInteger<1024>::multi_pow({$1[0], $1[1]}, {BigInteger<1024>(0), BigInteger<1024>(0)}) == 1);
+
+    bool flag = false;
+    try {
+      BigInteger<1024>::multi_pow($1, {$2[0]});
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
+  SECTION("Compound Assignment & Shift") {
+    BigInteger<2048> $1("233333333333333333333333333333333333333333333333333"), $2 = $1, $3;
+    BigInteger<2048> two(2);
+
+    // 复合赋值与对应的二元运算结果一致，左右两边是同一个对象时也成立
+    $2 += $1, $2 *= $1, $2 -= 12345;
+    REQUIRE($2 == ($1 + $1) * $1 - 12345);
+    $3 = $2, $3 += $3, $3 *= $3, $3 -= $3;
+    REQUIRE($3 == 0);
+    $3 -= 1;
+    REQUIRE($3.hex() == std::string(512, 'f'));
+
+    // 移位等价于乘除 2 的幂，超出 2^M 的部分被截断
+    REQUIRE(($2 << 1000) == $2 * (two ^ 1000));
+    REQUIRE(($2 >> 77) == $2 / (two ^ 77));
+    REQUIRE(($2 << 64 >> 64) == $2);
+    REQUIRE((BigInteger<2048>(1) << 2047).hex() == "8" + std::string(511, '0'));
+    REQUIRE((BigInteger<2048>(1) << 2048) == 0);
+    REQUIRE(($2 >> 2048) == 0);
+    $3 = $2, $3 <<= 333, $3 >>= 333;
+    REQUIRE($3 == $2);
+
+    // 移动构造与移动赋值
+    BigInteger<2048> $4(std::move($3));
+    REQUIRE($4 == $2);
+    $3 = std::move($4);
+    REQUIRE($3 == $2);
+  }
+
+  SECTION("Bitwise") {
+    auto $1 = BigInteger<100>::from_hex("f0f0f0f0f0f0f0f0f0f0f0f0f"), $2 = BigInteger<100>::from_hex("ff00ff00ff00ff00ff");
+    REQUIRE(($1 & $2).hex() == "f000f000f000f000f");
+    REQUIRE(($1 | $2).hex() == "f0f0f0fff0fff0fff0fff0fff");
+    REQUIRE(BigInteger<100>::bit_xor($1, $2).hex() == "f0f0f0ff00ff00ff00ff00ff0");
+    REQUIRE((~$1).hex() == "f0f0f0f0f0f0f0f0f0f0f0f0");
+    REQUIRE(~BigInteger<100>(0) == BigInteger<100>(0) - 1);
+    REQUIRE(($1 & 0xffULL) == 0x0f);
+    REQUIRE(($1 & BigInteger<100>(0)) == 0);
+
+    // 复合赋值，以及与自身运算
+    BigInteger<100> $3 = $1;
+    $3 &= $2, $3 |= 1;
+    REQUIRE($3.hex() == "f000f000f000f000f");
+    $3.xor_assign($3);
+    REQUIRE($3 == 0);
+
+    // 按位查询
+    REQUIRE($1.bit_length() == 100);
+    REQUIRE($2.bit_length() == 72);
+    REQUIRE(BigInteger<100>(0).bit_length() == 0);
+    REQUIRE($1.popcount() == 52);
+    REQUIRE((BigInteger<100>(0) - 1).popcount() == 100);
+    REQUIRE($2.test_bit(71) == true);
+    REQUIRE($2.test_bit(8) == false);
+    REQUIRE($2.test_bit(1000) == false);
+  }
+
+  SECTION("Batch Add & Sub") {
+    // 组数不是向量宽度的倍数，也超过一次转置的组数；覆盖进位、借位一直传播到最高块以及长度不同的情况
+    const std::size_t count = 150;
+    std::vector<BigInteger<1000>> $1(count), $2(count), $3(count);
+    BigInteger<1000> $4(1), $5(7), $6 = BigInteger<1000>(0) - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+      $4 = $4 * 0x9e3779b97f4a7c15ULL + i, $5 = $5 * 0xc2b2ae3d27d4eb4fULL + (i ^ 0x55);
+      $1[i] = i % 5 == 0 ? $6 : $4 >> (i * 7 % 300);
+      $2[i] = i % 7 == 0 ? BigInteger<1000>(i % 3) : $5 >> (i * 13 % 500);
+    }
+
+    LimbSimd::Level saved = LimbSimd::level();
+    for (auto level : {LimbSimd::SCALAR, LimbSimd::AVX2, LimbSimd::AVX512}) {
+      LimbSimd::set_level(level);
+
+      BigInteger<1000>::add_batch($1.data(), $2.data(), $3.data(), count);
+      for (std::size_t i = 0; i < count; ++i)
+        REQUIRE($3[i] == $1[i] + $2[i]);
+      BigInteger<1000>::sub_batch($1.data(), $2.data(), $3.data(), count);
+      for (std::size_t i = 0; i < count; ++i)
+        REQUIRE($3[i] == $1[i] - $2[i]);
+
+      // 结果写回输入
+      $3 = $1;
+      BigInteger<1000>::add_batch($3.data(), $2.data(), $3.data(), count);
+      BigInteger<1000>::sub_batch($3.data(), $2.data(), $3.data(), count);
+      for (std::size_t i = 0; i < count; ++i)
+        REQUIRE($3[i] == $1[i]);
+
+      // 比较在不同的块上出现差异
+      for (std::size_t k = 0; k < 1000; k += 61) {
+        BigInteger<1000> $7 = $6 - (BigInteger<1000>(1) << k);
+        REQUIRE($7 < $6);
+        REQUIRE($6 > $7);
+        REQUIRE($7 != $6);
+        REQUIRE($7 + (BigInteger<1000>(1) << k) == $6);
+      }
+    }
+    LimbSimd::set_level(saved);
+  }
+
   SECTION("Input Output") {
     std::string s0, s = "32317006071311007300714876688669951960444102669715484032130345427524655138867890893197201411522913463688717960921898019494119559150490921095088152386448283120630877367300996091750197750389652106796057638384067568276792218642619756161838094338476170470581645852036305042887575891541065808607552399123930385521914333389668342420684974786564569494856176035326322058077805659331026192708460314150258592864177116725943603718461857357598351152301645904403697613233287231227125684710820209725157101726931323469678542580656697935045997268352998638215525166389437335543602135433229604645318478604952148193555853611059596230655";
 
@@ -156,6 +517,35 @@ TEST_CASE("BigInteger", "[BigInteger]") {
     REQUIRE(flag == true);
   }
 
+  SECTION("Decimal Conversion") {
+    // 分段边界上的前导 0 和进位
+    std::string nines(1000, '9'), power = "1" + std::string(1000, '0');
+    REQUIRE(BigInteger<4096>(nines) + 1 == BigInteger<4096>(power));
+    REQUIRE((BigInteger<4096>(power) - 1).dec() == nines);
+    REQUIRE(BigInteger<4096>(power).dec() == power);
+
+    // 前导 0 以及超过 M 位的十进制输入（10^k 在 k >= M 时模 2^M 为 0）
+    REQUIRE(BigInteger<256>(std::string(500, '0') + "123") == 123);
+    REQUIRE(BigInteger<64>("1" + std::string(63, '0')) == 0x8000000000000000ULL);
+    REQUIRE(BigInteger<64>("1" + std::string(64, '0')) == 0);
+    REQUIRE(BigInteger<64>("7" + std::string(100, '0') + "42") == 42);
+
+    std::string hex;
+    for (std::size_t i = 0; i < 1024; ++i)
+      hex += "f0123456789abcde";
+    BigInteger<65536> $1 = BigInteger<65536>::from_hex(hex);
+    REQUIRE(BigInteger<65536>($1.dec()) == $1);
+    REQUIRE(BigInteger<65536>(($1 - 1).dec()) == $1 - 1);
+
+    // 大 M 下的转换：2^1000000 - 1 共 301030 位十进制数字
+    BigInteger<1000000> $2 = ~BigInteger<1000000>(0), $3 = $2 - ($1.widen<1000000>() << 500000);
+    std::string digits = $2.dec();
+    REQUIRE(digits.size() == 301030);
+    REQUIRE(digits.substr(0, 10) == "9900656229");
+    REQUIRE(BigInteger<1000000>(digits) == $2);
+    REQUIRE(BigInteger<1000000>($3.dec()) == $3);
+  }
+
   SECTION("Radix") {
     BigInteger<2048> $1("32317006071311007300714876688669951960444102669715484032130345427524655138867890893197201411522913463688717960921898019494119559150490921095088152386448283120630877367300996091750197750389652106796057638384067568276792218642619756161838094338476170470581645852036305042887575891541065808607552399123930385521914333389668342420684974786564569494856176035326322058077805659331026192708460314150258592864177116725943603718461857357598351152301645904403697613233287231227125684710820209725157101726931323469678542580656697935045997268352998638215525166389437335543602135433229604645318478604952148193555853611059596230655");
 
@@ -185,4 +575,615 @@ TEST_CASE("BigInteger", "[BigInteger]") {
     }
     REQUIRE(flag == true);
   }
-}
\ No newline at end of file
+
+  SECTION("Non-Aligned Modulus") {
+    BigInteger<40> $1(0xffffffffULL);
+    REQUIRE($1.hex() == "ffffffff");
+    REQUIRE($1 + 1 == 0x100000000ULL);
+    REQUIRE(BigInteger<40>(0x1ffffffffffULL) == 0xffffffffffULL);
+    REQUIRE(BigInteger<40>(1) - 2 == 0xffffffffffULL);
+    REQUIRE(BigInteger<40>(0x12345678ULL) * 0x10000 == 0x3456780000ULL);
+
+    BigInteger<2048> $2 = BigInteger<2048>::from_hex("100000000000000010000000f");
+    REQUIRE($2.hex() == "100000000000000010000000f");
+    REQUIRE(($2 - $2 - 1).hex() == std::string(512, 'f'));
+  }
+}
+
+TEST_CASE("MontgomeryContext", "[MontgomeryContext]") {
+  SECTION("Constructor") {
+    bool flag = false;
+    try {
+      MontgomeryContext<1024> $(BigInteger<1024>(100));
+    } catch (std::exception &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
+  SECTION("Mulmod & Powmod") {
+    auto n = BigInteger<2048>::from_hex("eb65a6a48b8148f6b38a088ca65ed389b74d0fb132e706298fadc1a606cb0fb39a1de644815ef6d13b8faa1837f8a88b17fc695a07a0ca6e0822e8f36c031199972a846916419f828b9d2434e465e150bd9c66b3ad3c2d6d1a3d1fa7bc8960a923b8c1e9392456de3eb13b9046685257bdd640fb06671ad11c80317fa3b1799d");
+    auto a = BigInteger<2048>::from_hex("f911ff49b7889463e85759cde66bacfb3d00b1f9163ce9ff57f43b7a3a69a8dca03580d7b71d8f564135be6128e18c267976142ea7d17be31111a2a73ed562b0f79c37459eef50bea63371ecd7b27cd813047229389571aa8766c307511b2b9437a28df6ec4ce4a2bbdc241330b01a9e71fde8a774bcf36d58b4737819096da1dac72ff5d2a386ecbe0");
+    auto e = BigInteger<2048>::from_hex("5d65a441d58842dea2bc372f7412b29347294739614ff3d719db3ad0ddd1dfb23b982ef8daf61a26146d3f31fc377a4c4a15544dc5e7ce8a3a578a8ea9488d990bbb259911ce5dd2b45ed1f03139d32c93cd59bf5c941cf0dc98d2c1e2acf72f9e574f7aa0ee89aed453dd324b0dbb418d5288f1142c3fe860e7a113ec1b8ca1");
+    auto b = BigInteger<2048>::from_hex("5af42e12f3838b3268e944239b02b61c4a3d70628ece66fa2fd5166e6451b4cf36123fdf77656af7229d4beef3eabedcbbaa80dd488bd64072bcfbe01a28defe39bf0027312476f57a5e5a5abaefcfad8efc89849b3aa7efe4458a885ab9099a435a240ae5af305535ec42e0829a3b2e9");
+    MontgomeryContext<2048> ctx(n);
+
+    REQUIRE(ctx.reduce(a).hex() == "6b372ab8194f3f9c0b17e3c7404093ff1a6a736bcbad7f1764a6f39e034123eb41073c2aa7171f503c4e786b9c6d3516ee23158b180da9b93706646f71d4ae5c55762b6681d01d8089ef1d4f91191d0664227869c669de413c05453e9cb071d6adda55c0c0c3ca963a908415e2f937b031bde24f9bd116cf4a90f6cceabed04d");
+    REQUIRE(ctx.mulmod(a, b).hex() == "b4f806b5d9f5cb4861a12d6b2a50a1c6e96cf375223b08646040555d6402a4b38f2614a2b64854858226853f3d9b08aa666e2e199efffa88ee0acaa1729dabbb4ec066213514e864042763ac37387851a33ec893953d1b3f27cb3f21291e77511aefbf4d430e40b1c5effd2a5d6e5e66a0d94c834ac87f766ca22c04f2fa0442");
+    REQUIRE(ctx.powmod(a, e).hex() == "3c014ccb654068d92fc6ea00962a9c91f1bf3690090a17b9c470d6f68a96cefd4ffb6caf5adb4234915969f0465c51410d65d19649ca7ebfeae95abdace6295e2416d49d1f9d114babb3cd08ec30684d0aa7795d2361e2cde419a93c65e2edde86a8706d6ca6dead2e9d1be5c4785e41b867a7608388c2780ba7b1c92de79b62");
+    REQUIRE(ctx.powmod(a, BigInteger<2048>(0)) == 1);
+  }
+
+  SECTION("Multi Powmod") {
+    auto n = BigInteger<1024>::from_hex("c7f1d3b5a7e9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9");
+    MontgomeryContext<1024> ctx(n);
+
+    // 项数少时使用 Straus，项数多时使用 Pippenger
+    for (std::size_t count : {2, 600}) {
+      std::vector<BigInteger<1024>> $1, $2;
+      BigInteger<1024> x(0x123456789abcdefULL), expected(1);
+      for (std::size_t i = 0; i < count; ++i) {
+        x = x * 0x9e3779b97f4a7c15ULL + i;
+        $1.push_back(i == 0 ? n + x : x), $2.push_back(count == 2 ? x : x >> 768);
+        expected = ctx.mulmod(expected, ctx.powmod($1.back(), $2.back()));
+      }
+      REQUIRE(ctx.multi_powmod($1, $2) == expected);
+    }
+  }
+
+  SECTION("Constant-Time Powmod") {
+    auto n = BigInteger<1024>::from_hex("c7f1d3b5a7e9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9");
+    MontgomeryContext<1024> ctx(n);
+    BigInteger<1024> a(0x123456789abcdefULL), e = n - 2;
+
+    REQUIRE(ctx.powmod_ct(a, e) == ctx.powmod(a, e));
+    REQUIRE(ctx.powmod_ct(n - 1, BigInteger<1024>(2)) == 1);
+    REQUIRE(ctx.powmod_ct(a, BigInteger<1024>(0)) == 1);
+    REQUIRE(ctx.powmod_ct(n + a, e) == ctx.powmod(a, e));
+
+    // 模数只占一部分块时，指数仍然按全部块处理
+    MontgomeryContext<1024> small(BigInteger<1024>(1000003));
+    REQUIRE(small.powmod_ct(a, BigInteger<1024>(1000002)) == 1);
+    REQUIRE(small.powmod_ct(a, e) == small.powmod(a, e));
+  }
+
+  SECTION("Fermat") {
+    // 2^255 - 19 是素数，由费马小定理 a^(p - 1) = 1 (mod p)
+    auto p = BigInteger<256>::from_hex("7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed");
+    MontgomeryContext<256> ctx(p);
+
+    REQUIRE(ctx.powmod(BigInteger<256>("12345678901234567890"), p - 1) == 1);
+    REQUIRE(ctx.powmod(p - 1, BigInteger<256>(2)) == 1);
+    REQUIRE(ctx.mulmod(p - 1, p - 1) == 1);
+  }
+}
+
+TEST_CASE("BarrettContext", "[BarrettContext]") {
+  SECTION("Constructor") {
+    bool flag = false;
+    try {
+      BarrettContext<1024> $(BigInteger<1024>(0));
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
+  SECTION("Reduce & Mulmod") {
+    // 与两倍宽度下的除法对照，模数覆盖单块、偶数、2 的幂和几乎占满 M 位的情况
+    BigInteger<1024> x(0x9e3779b97f4a7c15ULL);
+    for (std::size_t i = 0; i < 16; ++i)
+      x = x * 0xfedcba9876543211ULL + i;
+    BigInteger<1024> y = ~x;
+
+    std::vector<BigInteger<1024>> moduli{BigInteger<1024>(1), BigInteger<1024>(1000000), BigInteger<1024>(1) << 200,
+                                         (x >> 700) << 3, x >> 400, y >> 1, y};
+    for (const auto &n : moduli) {
+      BarrettContext<1024> ctx(n);
+      auto product = BigInteger<1024>::mul_wide(x, y) % n.widen<2048>();
+      REQUIRE(ctx.modulus() == n);
+      REQUIRE(ctx.reduce(x) == x % n);
+      REQUIRE(ctx.reduce(y) == y % n);
+      REQUIRE(ctx.reduce(n - 1) == n - 1);
+      REQUIRE(ctx.reduce(n) == 0);
+      REQUIRE(ctx.mulmod(x, y) == product.narrow<1024>());
+      REQUIRE(ctx.mulmod(ctx.reduce(x), ctx.reduce(y)) == product.narrow<1024>());
+      REQUIRE(ctx.reduce(BigInteger<1024>::mul_wide(x, y)) == product.narrow<1024>());
+      REQUIRE(ctx.reduce(~BigInteger<2048>(0)) == (~BigInteger<2048>(0) % n.widen<2048>()).narrow<1024>());
+    }
+  }
+
+  SECTION("Powmod") {
+    auto n = BigInteger<1024>::from_hex("c7f1d3b5a7e9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9c2b4d6f8e1a3c5b7d9f2e4a6c8b1d3f5e7a9");
+    BigInteger<1024> a(0x123456789abcdefULL), e = n - 2;
+
+    // 奇数模数与 Montgomery 的结果一致
+    REQUIRE(BarrettContext<1024>(n).powmod(a, e) == MontgomeryContext<1024>(n).powmod(a, e));
+    REQUIRE(BarrettContext<1024>(n).powmod(n + a, BigInteger<1024>(0)) == 1);
+
+    // 模 2^200 与直接截断的幂一致
+    BarrettContext<1024> power(BigInteger<1024>(1) << 200);
+    REQUIRE(power.powmod(a, e) == ((a ^ e) & ((BigInteger<1024>(1) << 200) - 1)));
+
+    // 偶数模数 n = 2^5 * q 与中国剩余定理的两部分分别一致
+    BigInteger<1024> q = n >> 300 | BigInteger<1024>(1);
+    BarrettContext<1024> even(q << 5);
+    auto r = even.powmod(a, e);
+    REQUIRE(r % q == MontgomeryContext<1024>(q).powmod(a, e));
+    REQUIRE(r % 32 == ((a ^ e) & 31));
+    REQUIRE(BarrettContext<1024>(BigInteger<1024>(1)).powmod(a, e) == 0);
+  }
+}
+
+TEST_CASE("BigIntegerBatch", "[BigIntegerBatch]") {
+  // 个数超过一组（TILE_LANES）且不是向量宽度的倍数，逐个与 BigInteger 的运算对照
+  const std::size_t count = 70;
+  std::vector<BigInteger<1000>> $1(count), $2(count);
+  BigInteger<1000> $3(1), $4(7), $5 = BigInteger<1000>(0) - 1;
+  for (std::size_t i = 0; i < count; ++i) {
+    $3 = $3 * 0x9e3779b97f4a7c15ULL + i, $4 = $4 * 0xc2b2ae3d27d4eb4fULL + (i ^ 0x55);
+    $1[i] = i % 9 == 0 ? $5 : $3 >> (i * 7 % 300);
+    $2[i] = i % 11 == 0 ? BigInteger<1000>(i % 3) : $4 >> (i * 13 % 900);
+  }
+  BigIntegerBatch<1000> a($1), b($2);
+
+  SECTION("Access") {
+    REQUIRE(a.size() == count);
+    REQUIRE(a.get(9) == $5);
+    REQUIRE(b.to_vector() == $2);
+
+    a.set(3, BigInteger<1000>(42));
+    REQUIRE(a.get(3) == 42);
+    REQUIRE(a.get(4) == $1[4]);
+
+    bool flag = false;
+    try {
+      BigIntegerBatch<1000>::add(a, BigIntegerBatch<1000>(count - 1));
+    } catch (std::exception &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
+  SECTION("Add & Sub & Mul") {
+    auto sum = BigIntegerBatch<1000>::add(a, b), diff = BigIntegerBatch<1000>::sub(a, b), prod = BigIntegerBatch<1000>::mul(a, b);
+    for (std::size_t i = 0; i < count; ++i) {
+      REQUIRE(sum.get(i) == $1[i] + $2[i]);
+      REQUIRE(diff.get(i) == $1[i] - $2[i]);
+      REQUIRE(prod.get(i) == $1[i] * $2[i]);
+    }
+  }
+
+  SECTION("Mulmod & Powmod") {
+    // 模数只占一部分块，输入中有超过模数块数的数
+    MontgomeryContext<1000> ctx((BigInteger<1000>(1) << 700) - 33), small(BigInteger<1000>(1000003));
+    std::vector<BigInteger<1000>> $6(count);
+    for (std::size_t i = 0; i < count; ++i)
+      $6[i] = i % 5 == 0 ? BigInteger<1000>(i) : $2[i] >> 600;
+    BigIntegerBatch<1000> e($6);
+
+    auto prod = BigIntegerBatch<1000>::mulmod(a, b, ctx), power = BigIntegerBatch<1000>::powmod(a, e, ctx);
+    auto prod_small = BigIntegerBatch<1000>::mulmod(a, b, small), power_small = BigIntegerBatch<1000>::powmod(a, e, small);
+    for (std::size_t i = 0; i < count; ++i) {
+      REQUIRE(prod.get(i) == ctx.mulmod($1[i], $2[i]));
+      REQUIRE(power.get(i) == ctx.powmod($1[i], $6[i]));
+      REQUIRE(prod_small.get(i) == small.mulmod($1[i], $2[i]));
+      REQUIRE(power_small.get(i) == small.powmod($1[i], $6[i]));
+    }
+
+    // 短指数使用长度为 1 的窗口
+    std::vector<BigInteger<1000>> $7(count);
+    for (std::size_t i = 0; i < count; ++i)
+      $7[i] = i % 2 == 0 ? BigInteger<1000>(65537) : BigInteger<1000>(i);
+    auto power_short = BigIntegerBatch<1000>::powmod(a, BigIntegerBatch<1000>($7), ctx);
+    for (std::size_t i = 0; i < count; ++i)
+      REQUIRE(power_short.get(i) == ctx.powmod($1[i], $7[i]));
+
+    // 指数全为 0
+    auto one = BigIntegerBatch<1000>::powmod(a, BigIntegerBatch<1000>(count), ctx);
+    for (std::size_t i = 0; i < count; ++i)
+      REQUIRE(one.get(i) == 1);
+  }
+}
+
+TEST_CASE("ThreadPool", "[ThreadPool]") {
+  SECTION("Invoke") {
+    // 没有线程时依次执行
+    ThreadPool serial(0);
+    std::vector<int> order;
+    serial.invoke([&] { order.push_back(1); }, [&] { order.push_back(2); });
+    REQUIRE(serial.size() == 0);
+    REQUIRE(order == std::vector<int>{1, 2});
+
+    // 嵌套调用，所有任务都恰好执行一次
+    ThreadPool pool(3);
+    std::atomic<int> sum(0);
+    std::function<void(int)> split = [&](int depth) {
+      if (depth == 0) {
+        ++sum;
+        return;
+      }
+      pool.invoke([&] { split(depth - 1); }, [&] { split(depth - 1); }, [&] { split(depth - 1); });
+    };
+    split(5);
+    REQUIRE(pool.size() == 3);
+    REQUIRE(sum == 243);
+
+    // 异常在全部任务完成后抛出
+    bool flag = false, finished = false;
+    try {
+      pool.invoke([] { throw std::logic_error("failed"); }, [&] { finished = true; });
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+    REQUIRE(finished == true);
+  }
+
+  SECTION("Parallel Mul") {
+    typedef BigIntegerAccess A;
+
+    // 覆盖 Toom-Cook、短乘法、短平方和 NTT 的并行分支，与串行的朴素乘法对照
+    BigInteger<131072> $1(3), $2(5);
+    for (std::size_t i = 0; i < 1500; ++i)
+      $1 = $1 * 0xfedcba9876543211ULL + i, $2 = $2 * 0x123456789abcdefULL + i;
+    BigInteger<131072> $3 = $1 << 40000, $4 = $2 >> 20000;
+    BigInteger<524288> $5(7);
+    for (std::size_t i = 0; i < 4096; ++i)
+      $5 = $5 * 0x9e3779b97f4a7c15ULL + i;
+
+    ThreadPool::set_global_size(4);
+    REQUIRE(ThreadPool::global().size() == 4);
+    REQUIRE($1 * $2 == A::mul_base($1, $2));
+    REQUIRE($3 * $2 == A::mul_base($3, $2));
+    REQUIRE($1 * $4 == A::mul_base($1, $4));
+    REQUIRE(BigInteger<131072>::sqr($3) == A::mul_base($3, $3));
+    REQUIRE(A::mul_toom3($1, $2) == A::mul_toom4($1, $2));
+    REQUIRE($5 * $5 == A::mul_base($5, $5));
+    ThreadPool::set_global_size(0);
+    REQUIRE(ThreadPool::global().size() == 0);
+  }
+}
+
+TEST_CASE("FixedBasePow", "[FixedBasePow]") {
+  SECTION("Constructor") {
+    bool flag = false;
+    try {
+      FixedBasePow<256> $(BigInteger<256>(3), 256, 3);
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+
+    FixedBasePow<256> $1(BigInteger<256>(3), 100, 8);
+    REQUIRE($1.window_length() == 8);
+    REQUIRE($1.max_exponent_bits() == 100);
+    REQUIRE($1.table_size() == 13 * 255);
+
+    flag = false;
+    try {
+      $1.pow(BigInteger<256>(1) << 100);
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+
+  SECTION("Modulo 2^M") {
+    BigInteger<1024> g(0x9e3779b97f4a7c15ULL), e(1);
+    for (std::size_t i = 0; i < 20; ++i)
+      e = e * 0xfedcba9876543211ULL + i;
+
+    for (std::size_t w : {1, 2, 4, 8}) {
+      FixedBasePow<1024> $(g, 1024, w);
+      REQUIRE($.pow(e) == (g ^ e));
+      REQUIRE($.pow(e >> 700) == (g ^ (e >> 700)));
+      REQUIRE($.pow(BigInteger<1024>(0)) == 1);
+      REQUIRE($.pow(BigInteger<1024>(1)) == g);
+    }
+
+    // 偶数底数的高次幂为 0
+    FixedBasePow<256> $2(BigInteger<256>(6));
+    REQUIRE($2.pow(BigInteger<256>(255)) == (BigInteger<256>(6) ^ BigInteger<256>(255)));
+    REQUIRE($2.pow(BigInteger<256>(256)) == 0);
+  }
+
+  SECTION("Modulo n") {
+    auto n = BigInteger<2048>::from_hex("eb65a6a48b8148f6b38a088ca65ed389b74d0fb132e706298fadc1a606cb0fb39a1de644815ef6d13b8faa1837f8a88b17fc695a07a0ca6e0822e8f36c031199972a846916419f828b9d2434e465e150bd9c66b3ad3c2d6d1a3d1fa7bc8960a923b8c1e9392456de3eb13b9046685257bdd640fb06671ad11c80317fa3b1799d");
+    MontgomeryContext<2048> ctx(n);
+    BigInteger<2048> g = n + 5, e = n - 2;
+
+    FixedBasePow<2048> $(g, ctx);
+    REQUIRE($.pow(e) == ctx.powmod(g, e));
+    REQUIRE($.pow(e >> 1500) == ctx.powmod(g, e >> 1500));
+    REQUIRE($.pow(BigInteger<2048>(0)) == 1);
+
+    // 全局线程池有线程时并行建表和求值，结果与串行相同
+    ThreadPool::set_global_size(3);
+    FixedBasePow<2048> $1(g, ctx, 2048, 2);
+    REQUIRE($1.pow(e) == ctx.powmod(g, e));
+    REQUIRE($.pow(e) == ctx.powmod(g, e));
+    ThreadPool::set_global_size(0);
+
+    MontgomeryContext<2048> one(BigInteger<2048>(1));
+    REQUIRE(FixedBasePow<2048>(g, one).pow(e) == 0);
+  }
+}
+
+TEST_CASE("BigIntegerExpr", "[BigIntegerExpr]") {
+  BigInteger<1000> a(0x9e3779b97f4a7c15ULL), b(0xc2b2ae3d27d4eb4fULL), c(0x165667b19e3779f9ULL);
+  for (std::size_t i = 0; i < 12; ++i)
+    a = a * 0xfedcba9876543211ULL + i, b = b * 0x9e3779b97f4a7c15ULL + (i ^ 0x55), c = c * 0x27d4eb2f165667c5ULL + i;
+  BigInteger<1000> top = ~BigInteger<1000>(0), zero;
+
+  SECTION("Linear Combination") {
+    // 与普通运算符逐步计算的结果对照，覆盖结果为负、需要截断、操作数长度不同的情况
+    BigInteger<1000> r1 = lazy(a) + lazy(b) - lazy(c);
+    REQUIRE(r1 == a + b - c);
+    BigInteger<1000> r2 = lazy(c) * 3 - lazy(a) * 7 + b;
+    REQUIRE(r2 == c * 3 - a * 7 + b);
+    REQUIRE((lazy(zero) - a).eval() == zero - a);
+    REQUIRE((lazy(top) + top + top).eval() == top * 3);
+    REQUIRE((lazy(a) - a).eval() == 0);
+    REQUIRE((-lazy(a >> 900)).eval() == zero - (a >> 900));
+    REQUIRE((5 * lazy(a) - (lazy(b) - c) * 2).eval() == a * 5 - (b - c) * 2);
+    REQUIRE((b - lazy(a) * -4).eval() == b + a * 4);
+
+    BigInteger<64> small(0xffffffffffffffffULL);
+    REQUIRE((lazy(small) * 6 + small).eval() == small * 7);
+  }
+
+  SECTION("Shift") {
+    for (std::size_t s : {0, 1, 31, 32, 63, 64, 65, 500, 999, 1000, 5000}) {
+      REQUIRE((lazy(a) << s).eval() == (a << s));
+      REQUIRE((lazy(a) * 3 + (lazy(b) << s) - (lazy(c) << s) * 2).eval() == a * 3 + (b << s) - (c << s) * 2);
+    }
+    REQUIRE(((lazy(a) << 600) << 600).eval() == 0);
+  }
+
+  SECTION("Large Coefficient") {
+    // 系数超过一块（32 位块）或左移后超过一块时拆成多遍累加，结果不变
+    std::int64_t k = 0x7fffffffffffffffLL;
+    REQUIRE((lazy(a) * k - lazy(b) * k).eval() == (a - b) * BigInteger<1000>(k));
+    REQUIRE((lazy(a) * (1LL << 40) + lazy(b) * (1LL << 40)).eval() == (a + b) << 40);
+
+    bool flag = false;
+    try {
+      lazy(a) * k * 2;
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+}
+
+TEST_CASE("BigIntegerLiteral", "[BigIntegerLiteral]") {
+  // NIST P-256 的模数，在编译期由字面量和运算两种方式得到
+  constexpr auto p = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff_big;
+  constexpr auto one = (1_big).widen<256>();
+  static_assert(p == (one << 256) - (one << 224) + (one << 192) + (one << 96) - one, "P-256 modulus");
+  static_assert((p >> 192) == (0xffffffff00000001_big).widen<256>(), "shift right");
+  static_assert((p * p).narrow<64>() == (1_big).widen<64>(), "low limb of p^2");
+  static_assert(BigIntegerLiteral<64>("0xffff'ffff'ffff'ffff") + BigIntegerLiteral<64>(1) == BigIntegerLiteral<64>(), "wrap around");
+
+  SECTION("Conversion") {
+    BigInteger<256> x = p;
+    REQUIRE(x == BigInteger<256>::from_hex("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff"));
+    REQUIRE(BigInteger<128>(p) == BigInteger<128>::from_hex("ffffffffffffffffffffffff"));
+    REQUIRE(BigInteger<1024>(p) == x.widen<1024>());
+
+    BigInteger<512> d = 115792089210356248762697446949407573530086143415290314195533631308867097853951_big;
+    REQUIRE(d == x.widen<512>());
+    REQUIRE(BigInteger<64>(1'000'000'007_big) == 1000000007);
+    REQUIRE(BigInteger<64>(0b1011'0001_big) == 177);
+    REQUIRE(BigInteger<64>(0777_big) == 511);
+    REQUIRE(BigInteger<64>(0_big) == 0);
+    REQUIRE(BigInteger<100>(BigIntegerLiteral<100>("0x1fffffffffffffffffffffffffff")) == ~BigInteger<100>(0));
+  }
+
+  SECTION("Arithmetic") {
+    // 与运行期的 BigInteger 运算对照
+    constexpr BigIntegerLiteral<1000> a("0x9e3779b97f4a7c15f39cc0605cedc8341082276bf3a27251f86c6a11d0c18e952767f0b153d27b7f0347045b5bf1827f0188"),
+                                       b("123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890");
+    BigInteger<1000> x = a, y = b;
+    REQUIRE(BigInteger<1000>(a + b) == x + y);
+    REQUIRE(BigInteger<1000>(b - a) == y - x);
+    REQUIRE(BigInteger<1000>(a * b) == x * y);
+    REQUIRE(BigInteger<1000>(a * a * a) == x * x * x);
+    for (std::size_t s : {0, 1, 31, 32, 63, 64, 65, 500, 999, 1000}) {
+      REQUIRE(BigInteger<1000>(a << s) == (x << s));
+      REQUIRE(BigInteger<1000>(a >> s) == (x >> s));
+    }
+    REQUIRE(BigInteger<500>(a.narrow<500>()) == x.narrow<500>());
+  }
+
+  SECTION("Invalid Digits") {
+    bool flag = false;
+    try {
+      BigIntegerLiteral<64> $("0x12g4");
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+
+    flag = false;
+    try {
+      BigIntegerLiteral<64> $("0b");
+    } catch (std::logic_error &e) {
+      flag = true;
+    }
+    REQUIRE(flag == true);
+  }
+}
+
+// 静态存储期的链表在所有 thread_local 对象析构之后才析构，节点的内存不能随线程局部的内存池一起释放
+List<unsigned> static_list(3, 9);
+
+TEST_CASE("List", "[List]") {
+  SECTION("Basic Operations") {
+    List<unsigned> $1(3, 7);
+    $1.push_back(8), $1.push_front(6);
+    REQUIRE($1.size() == 5);
+    REQUIRE($1.front() == 6);
+    REQUIRE($1.back() == 8);
+
+    auto $2 = $1.split(2);
+    REQUIRE($2.first.size() == 2);
+    REQUIRE($2.second.size() == 3);
+    REQUIRE($2.first + $2.second == $1);
+
+    $1.clear();
+    REQUIRE($1.empty());
+    $1.push_back(1);
+    REQUIRE($1.front() == 1);
+
+    // split 对任意元素类型都可用
+    List<std::string> $3(2, "big");
+    REQUIRE($3.split(1).second.front() == "big");
+  }
+
+  SECTION("Node Pool") {
+    // 释放的节点回到当前线程的内存池，下一次分配时会被重新使用
+    List<unsigned> $1;
+    $1.push_back(1);
+    ListNode<unsigned> *$2 = $1.begin().raw();
+    $1.pop_back();
+    $1.push_back(2);
+    REQUIRE($1.begin().raw() == $2);
+    REQUIRE($1.front() == 2);
+  }
+
+  SECTION("Node Ownership") {
+    // 反复复制、重建、分裂、删除之后，存活的节点数应当回到原来的值
+    ListAllocStats &stats = ListAllocStats::local();
+    std::size_t live = stats.live_nodes;
+    stats.reset();
+
+    for (unsigned round = 0; round < 100; ++round) {
+      List<unsigned> $1(50, round), $2($1);
+      $1.reconstruct($2);
+      $2.reconstruct(20, 1);
+      $2.push_back(2), $2.push_back(1);
+      REQUIRE($2.erase(1) == 21);
+      REQUIRE($2.size() == 1);
+
+      auto $3 = $1.split(25);
+      $3.first += $3.second;
+      $1.clear();
+      $1 = std::move($3.first);
+      REQUIRE($1.size() == 50);
+    }
+
+    REQUIRE(stats.live_nodes == live);
+    REQUIRE(stats.peak_nodes < live + 400);
+    REQUIRE(stats.total_allocations > 10000);
+  }
+
+  SECTION("Move Semantics") {
+    // 右值的拼接和分裂直接转移节点，只会分配头节点
+    ListAllocStats &stats = ListAllocStats::local();
+    List<unsigned> $1(100, 1), $2(50, 2);
+
+    stats.reset();
+    List<unsigned> $3 = std::move($1) + $2;
+    REQUIRE($3.size() == 150);
+    REQUIRE($1.empty());
+    REQUIRE(stats.total_allocations <= 50 + 2);
+
+    stats.reset();
+    auto $4 = std::move($3).split(120);
+    REQUIRE(stats.total_allocations <= 4);
+    REQUIRE($4.first.size() == 120);
+    REQUIRE($4.second.size() == 30);
+    REQUIRE($4.first.back() == 2);
+    REQUIRE($4.second == List<unsigned>(30, 2));
+    REQUIRE(std::move($4.second).split(100).second.empty());
+
+    // 左值仍然复制每个元素
+    stats.reset();
+    auto $5 = $4.first.split(60);
+    REQUIRE(stats.total_allocations >= 120);
+    REQUIRE($5.first + $5.second == $4.first);
+
+    // 拷贝赋值与自身拼接
+    List<unsigned> $6;
+    $6 = $5.second;
+    REQUIRE($6 == $5.second);
+    const List<unsigned> &$7 = $6;
+    $6 = $7;
+    $6 += $6;
+    REQUIRE($6.size() == 120);
+
+    // 元素本身也可以移入节点
+    List<std::string> $8;
+    std::string $9(100, 'x');
+    $8.push_back(std::move($9));
+    $8.push_front(std::string(10, 'y'));
+    REQUIRE($8.back().size() == 100);
+    REQUIRE($8.front() == "yyyyyyyyyy");
+
+    // 移动构造不分配内存，被移走的链表在下一次插入时才重新创建头节点
+    static_assert(std::is_nothrow_move_constructible<List<unsigned>>::value, "List move constructor must be noexcept");
+    List<unsigned> $10(5, 7);
+    stats.reset();
+    List<unsigned> $11(std::move($10));
+    REQUIRE(stats.total_allocations == 0);
+    REQUIRE($10.empty());
+    REQUIRE($10.size() == 0);
+    REQUIRE($10.begin() == $10.end());
+    REQUIRE($10 == List<unsigned>());
+    List<unsigned> $12($10);
+    REQUIRE($12.empty());
+    $10.push_back(3);
+    $10.push_front(1);
+    $10.insert(--$10.end(), 2);
+    REQUIRE($10.size() == 3);
+    REQUIRE($10.front() == 1);
+    REQUIRE($10.back() == 3);
+    List<unsigned> $13(std::move($11)), $14;
+    $14 = std::move($11);
+    REQUIRE($14.empty());
+    $11 = $13;
+    REQUIRE($11 == List<unsigned>(5, 7));
+  }
+
+  SECTION("Node Lifetime") {
+    // 在其他线程上构造的链表在该线程结束之后仍然可以使用和释放
+    List<unsigned> *$1 = nullptr;
+    std::thread $2([&] { $1 = new List<unsigned>(100, 7); });
+    $2.join();
+    $1->push_back(8);
+    REQUIRE($1->size() == 101);
+    REQUIRE($1->back() == 8);
+
+    // 结束的线程留下的节点被之后的线程重新使用，静态链表在线程之间共享节点
+    for (unsigned i = 0; i < 20; ++i) {
+      std::thread $3([&] {
+        List<unsigned> $4(1000, i);
+        static_list.push_back($4.back());
+      });
+      $3.join();
+    }
+    delete $1;
+    REQUIRE(static_list.size() == 23);
+    REQUIRE(static_list.front() == 9);
+    REQUIRE(static_list.back() == 19);
+  }
+
+  SECTION("Arena") {
+    ListArena<unsigned> $1(4);
+    {
+      List<unsigned, ListArenaAllocator<unsigned>> $2{ListArenaAllocator<unsigned>($1)}, $3($2);
+      for (unsigned i = 0; i < 100; ++i)
+        $2.push_back(i), $3.push_front(i);
+      REQUIRE($2.size() == 100);
+      REQUIRE($2.back() == 99);
+      REQUIRE($3.front() == 99);
+
+      auto $4 = $2.split(50);
+      REQUIRE($4.second.front() == 50);
+    }
+    // 所有节点在这里一次性释放
+    $1.release();
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef FDS_THREAD_POOL_
+#define FDS_THREAD_POOL_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 用于分治乘法的 fork-join 线程池（工作窃取）
+// 每个工作线程有自己的双端队列：自己从尾部取任务（后进先出，优先处理刚分出的子问题），空闲时从其他队列的头部窃取
+// 不属于线程池的线程（例如主线程）提交的任务放在一个共用的队列中
+// invoke 在等待子任务时会帮忙执行队列中的其他任务，因此嵌套调用不会死锁
+// 线程数为 0 时不创建线程，invoke 退化为依次执行
+class ThreadPool {
+ public: // 构造与析构
+  explicit ThreadPool(std::size_t threads); // threads 为工作线程数，创建失败时只保留已经创建的线程
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  auto operator=(const ThreadPool &) -> ThreadPool& = delete;
+
+ public: // 线程数
+  auto size() const -> std::size_t;
+
+ public: // 并行执行 f...，全部完成后返回；第一个函数由调用者自己执行，任何一个抛出的异常都会在全部完成后重新抛出
+  template <class... F>
+  auto invoke(F&&... f) -> void;
+  auto invoke_all(std::vector<std::function<void()>> &fns) -> void; // 个数在运行时才确定的版本
+
+ public: // 全局线程池，乘法的并行模式使用它；默认线程数为 0，即只使用串行实现
+  static auto global() -> ThreadPool&;
+  static auto set_global_size(std::size_t threads) -> void; // 重新创建全局线程池，不能在全局线程池使用期间调用
+  static auto hardware_threads() -> std::size_t; // 硬件支持的并发线程数，未知时为 1
+
+ private: // 任务和队列
+  struct Task {
+    std::function<void()> fn;
+    std::exception_ptr error;
+    std::atomic<bool> done{false};
+  };
+  struct Queue {
+    std::mutex lock;
+    std::deque<Task*> tasks;
+  };
+
+ private: // 数据
+  std::vector<std::unique_ptr<Queue>> queues; // 第 i 个属于第 i 个工作线程，最后一个由外部线程共用
+  std::vector<std::thread> workers;
+  std::mutex sleep_lock;
+  std::condition_variable wake;
+  std::atomic<std::size_t> pending{0}; // 仍在队列中的任务数
+  std::atomic<bool> stopping{false};
+
+ private: // 辅助函数
+  auto queue_index() const -> std::size_t; // 当前线程使用的队列
+  auto push(std::size_t index, Task *task) -> void;
+  auto find_task(std::size_t index) -> Task*; // 先取自己队列的尾部，再依次窃取其他队列的头部
+  auto execute(Task *task) -> void;
+  auto worker_loop(std::size_t index) -> void;
+  static auto current() -> std::pair<const ThreadPool*, std::size_t>&; // 当前线程所属的线程池和编号
+  static auto instance() -> std::unique_ptr<ThreadPool>&;
+};
+
+#endif //FDS_THREAD_POOL_
+
+#include "thread_pool_impl.h"
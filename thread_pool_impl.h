@@ -0,0 +1,191 @@
+#ifndef FDS_THREAD_POOL_IMPL_
+#define FDS_THREAD_POOL_IMPL_
+
+#include "thread_pool.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// ThreadPool 构造与析构
+
+inline ThreadPool::ThreadPool(std::size_t threads) {
+  for (std::size_t i = 0; i <= threads; ++i)
+    queues.emplace_back(new Queue());
+
+  // 队列必须先全部建好，工作线程一启动就可能去窃取
+  workers.reserve(threads);
+  try {
+    for (std::size_t i = 0; i < threads; ++i)
+      workers.emplace_back(&ThreadPool::worker_loop, this, i);
+  } catch (const std::system_error &) {
+    // 无法创建更多线程时只保留已经创建的线程，多出的队列始终为空
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(sleep_lock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &t : workers)
+    t.join();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 线程数
+
+inline auto ThreadPool::size() const -> std::size_t { return workers.size(); }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 并行执行
+
+template <class... F>
+auto ThreadPool::invoke(F&&... f) -> void {
+  std::vector<std::function<void()>> fns{std::function<void()>(std::forward<F>(f))...};
+  invoke_all(fns);
+}
+
+inline auto ThreadPool::invoke_all(std::vector<std::function<void()>> &fns) -> void {
+  if (workers.empty() || fns.size() < 2) {
+    for (auto &fn : fns)
+      fn();
+    return;
+  }
+
+  // 除第一个以外的函数放进当前线程的队列，等待其他线程窃取
+  std::size_t index = queue_index(), count = fns.size() - 1;
+  std::unique_ptr<Task[]> tasks(new Task[count]);
+  for (std::size_t i = 0; i < count; ++i) {
+    tasks[i].fn = std::move(fns[i + 1]);
+    push(index, &tasks[i]);
+  }
+
+  std::exception_ptr error;
+  try {
+    fns[0]();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // tasks 只在本函数内有效，必须等全部完成才能返回；等待期间帮忙执行其他任务（通常就是自己刚放进去的任务）
+  for (std::size_t i = 0; i < count; ++i) {
+    while (!tasks[i].done.load(std::memory_order_acquire)) {
+      Task *other = find_task(index);
+      if (other != nullptr)
+        execute(other);
+      else
+        std::this_thread::yield();
+    }
+    if (!error && tasks[i].error)
+      error = tasks[i].error;
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 全局线程池
+
+inline auto ThreadPool::global() -> ThreadPool& { return *instance(); }
+
+inline auto ThreadPool::set_global_size(std::size_t threads) -> void {
+  std::unique_ptr<ThreadPool> &pool = instance();
+  if (pool->size() == threads)
+    return;
+  pool.reset();
+  pool.reset(new ThreadPool(threads));
+}
+
+inline auto ThreadPool::hardware_threads() -> std::size_t {
+  std::size_t n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+inline auto ThreadPool::instance() -> std::unique_ptr<ThreadPool>& {
+  static std::unique_ptr<ThreadPool> pool(new ThreadPool(0));
+  return pool;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 current、queue_index
+
+inline auto ThreadPool::current() -> std::pair<const ThreadPool*, std::size_t>& {
+  static thread_local std::pair<const ThreadPool*, std::size_t> owner(nullptr, 0);
+  return owner;
+}
+
+inline auto ThreadPool::queue_index() const -> std::size_t {
+  const auto &owner = current();
+  return owner.first == this ? owner.second : queues.size() - 1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 push、find_task
+// pending 在持有 sleep_lock 时增加，保证休眠中的工作线程不会错过唤醒
+
+inline auto ThreadPool::push(std::size_t index, Task *task) -> void {
+  {
+    std::lock_guard<std::mutex> guard(queues[index]->lock);
+    queues[index]->tasks.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> guard(sleep_lock);
+    ++pending;
+  }
+  wake.notify_one();
+}
+
+inline auto ThreadPool::find_task(std::size_t index) -> Task* {
+  std::size_t n = queues.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    Queue &q = *queues[(index + i) % n];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.tasks.empty())
+      continue;
+
+    Task *task;
+    if (i == 0) {
+      task = q.tasks.back();
+      q.tasks.pop_back();
+    } else {
+      task = q.tasks.front();
+      q.tasks.pop_front();
+    }
+    --pending;
+    return task;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+// 辅助函数 execute、worker_loop
+
+inline auto ThreadPool::execute(Task *task) -> void {
+  try {
+    task->fn();
+  } catch (...) {
+    task->error = std::current_exception();
+  }
+  task->done.store(true, std::memory_order_release);
+}
+
+inline auto ThreadPool::worker_loop(std::size_t index) -> void {
+  current() = std::make_pair(this, index);
+
+  while (true) {
+    Task *task = find_task(index);
+    if (task != nullptr) {
+      execute(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> guard(sleep_lock);
+    wake.wait(guard, [this] { return stopping || pending > 0; });
+    if (stopping && pending == 0)
+      return;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#endif //FDS_THREAD_POOL_IMPL_